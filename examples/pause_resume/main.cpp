@@ -0,0 +1,167 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+// glfwmPauseResume
+//
+// This example stresses the handoff of a window between the threads drawing
+// a group and the main thread, and doubles as a test (run it with ctest).
+// A hidden window with an OpenGL context is attached to a group, whose loop
+// is first started and stopped many times, then paused and resumed many
+// times. While paused, the window is drawn by the main thread; otherwise, by
+// the thread of the group or by the workers of the Executor. This is done
+// with the loop running on its own thread and on the Executor, both waiting
+// for updates and polling at a target frame rate, so that pausing has to
+// cancel the delayed task waking the group up for its next frame.
+// Each draw checks that the context of the window is current on the drawing
+// thread, and any GLFW error is counted, e.g. when a context is made current
+// while still current on another thread.
+// The program returns 0 if every draw happened as expected, 1 otherwise.
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <GLFWM/glfwm.hpp>
+
+static const int RunStopCycles = 200;
+static const int PauseResumeCycles = 2000;
+static const double PollingFrameRate = 500.0;
+
+std::atomic<int> errors(0);
+
+void errorCallback(int code, const char* description) {
+	std::cerr << "GLFW error " << code << ": " << description << std::endl;
+	++errors;
+}
+
+// This class counts the draws made by the main thread and by the other threads.
+class CountingDrawable : public glfwm::Drawable {
+  public:
+	CountingDrawable() : mainThreadDraws(0), concurrentDraws(0) {}
+
+	void draw(const glfwm::WindowID id) override {
+		if (!glfwGetCurrentContext()) {
+			std::cerr << "Drawing window " << id << " without its context current" << std::endl;
+			++errors;
+		}
+		if (glfwm::WindowManager::isMainThread())
+			++mainThreadDraws;
+		else
+			++concurrentDraws;
+	}
+
+	std::atomic<int> mainThreadDraws;
+	std::atomic<int> concurrentDraws;
+};
+
+// Starts the loop of a group, on its own thread or on the Executor.
+void run(const glfwm::WindowGroupPointer& grp, const bool onExecutor) {
+	if (onExecutor)
+		grp->runLoopOnExecutor();
+	else
+		grp->runLoopConcurrently();
+}
+
+// Makes the running group draw the window, and waits until it has been drawn by another thread.
+bool drawConcurrently(const glfwm::WindowGroupPointer& grp, const glfwm::WindowID id, const CountingDrawable& drawable) {
+	const int count = drawable.concurrentDraws + 1;
+	grp->setWindowToUpdate(id);
+	grp->process();
+	const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (drawable.concurrentDraws < count) {
+		if (std::chrono::steady_clock::now() > deadline) {
+			std::cerr << "The group did not draw in time" << std::endl;
+			++errors;
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+	return true;
+}
+
+// Makes the paused group draw the window, which must happen on the main thread.
+bool drawPaused(const glfwm::WindowGroupPointer& grp, const glfwm::WindowID id, const CountingDrawable& drawable) {
+	const int count = drawable.mainThreadDraws + 1;
+	grp->setWindowToUpdate(id);
+	grp->process();
+	if (drawable.mainThreadDraws != count) {
+		std::cerr << "The main thread did not draw while paused" << std::endl;
+		++errors;
+		return false;
+	}
+	return true;
+}
+
+// Runs the cycles on a new group drawing the window, deleted at the end.
+bool test(const glfwm::WindowID id, const CountingDrawable& drawable, const bool onExecutor, const bool poll) {
+	glfwm::WindowGroupPointer grp = glfwm::WindowGroup::newGroup();
+	grp->attachWindow(id);
+	if (poll) {
+		grp->setPoll(true);
+		grp->setTargetFrameRate(PollingFrameRate);
+	}
+
+	// start and stop the loop: each time it starts from scratch
+	for (int i = 0; i < RunStopCycles && errors == 0; ++i) {
+		run(grp, onExecutor);
+		drawConcurrently(grp, id, drawable);
+		grp->stopAndWait();
+	}
+
+	// pause and resume the loop: the window is drawn by the main thread and by the group in turn
+	run(grp, onExecutor);
+	for (int i = 0; i < PauseResumeCycles && errors == 0; ++i) {
+		grp->pause();
+		if (!drawPaused(grp, id, drawable))
+			break;
+		grp->resume();
+		if (!drawConcurrently(grp, id, drawable))
+			break;
+	}
+	grp->stopAndWait();
+
+	glfwm::WindowGroup::deleteWindowGroup(grp->getID());
+	if (errors > 0)
+		std::cerr << "Failed running " << (onExecutor ? "on the Executor" : "on a thread") << ", "
+		          << (poll ? "polling" : "waiting") << std::endl;
+	return errors == 0;
+}
+
+int main() {
+	glfwSetErrorCallback(errorCallback);
+	if (!glfwm::WindowManager::init())
+		return 1;
+	glfwm::WindowManager::setHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	std::shared_ptr<CountingDrawable> drawable = std::make_shared<CountingDrawable>();
+	glfwm::WindowPointer win = glfwm::WindowManager::createWindow(64, 64, std::string("Pause & resume"));
+	if (!win) {
+		glfwm::WindowManager::terminate();
+		return 1;
+	}
+	win->bindDrawable(drawable, 0);
+
+	const bool passed = test(win->getID(), *drawable, false, false) && test(win->getID(), *drawable, false, true)
+	                    && test(win->getID(), *drawable, true, false) && test(win->getID(), *drawable, true, true);
+
+	glfwm::WindowManager::terminate();
+
+	if (!passed) {
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Drawn " << drawable->concurrentDraws << " times by the groups and " << drawable->mainThreadDraws
+	          << " times by the main thread" << std::endl;
+	return 0;
+}
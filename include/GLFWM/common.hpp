@@ -15,6 +15,9 @@
 #define GLFWM_COMMON_HPP
 
 // C++ standard library
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <deque>
 #include <exception>
 #include <fstream>
@@ -22,11 +25,13 @@
 #include <iterator>
 #include <limits>
 #include <list>
+#include <map>
 #include <memory>
 #include <queue>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
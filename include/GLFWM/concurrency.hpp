@@ -0,0 +1,349 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_CONCURRENCY_HPP
+#define GLFWM_CONCURRENCY_HPP
+
+#include <GLFWM/common.hpp>
+#ifndef NO_MULTITHREADING
+#include <atomic>
+
+namespace glfwm {
+
+	class ElidableMutexBase;
+
+	/**
+	 *  @brief  The Concurrency class tracks whether threads other than the main one may be using the library. While
+	 * none may, the main thread skips the ElidableMutexes, as no other thread can contend for them.
+	 *  @note   Any other thread locking an ElidableMutex becomes a user of the library until its end: concurrency is
+	 * switched on, and the thread waits for the main thread to leave the sections whose lock it skipped, as it would
+	 * wait for the lock itself. The threads started by the library (concurrent group loops, presenters, Executor
+	 * workers and the Watchdog) declare themselves with enable and disable as well.
+	 */
+	class Concurrency {
+	  public:
+		/**
+		 *  @brief  The enable static method declares a new user of the library other than the main thread, e.g.
+		 * before starting a thread, so that concurrency is active by the time it calls the library.
+		 */
+		static void enable();
+
+		/**
+		 *  @brief  The disable static method declares that a user declared with enable is not going to call the library
+		 * any more, e.g. at the end of its thread.
+		 *  @note   Concurrency is switched off at the beginning of the next iteration of the main loop without users.
+		 */
+		static void disable();
+
+		/**
+		 *  @brief  The isActive static method says if the locks are being acquired.
+		 *  @return true if concurrency is active, false otherwise.
+		 */
+		static bool isActive();
+
+		/**
+		 *  @brief  The setMainThread static method sets the calling thread as the main one, allowed to skip the locks
+		 * while concurrency is not active. Called by WindowManager::init.
+		 */
+		static void setMainThread();
+
+		/**
+		 *  @brief  The quiesce static method switches concurrency off if there are no more users. To be called by the
+		 * main thread while holding no ElidableMutex, as at the beginning of each iteration of the main loop.
+		 */
+		static void quiesce();
+
+	  private:
+		// The ElidableMutex is friend for letting it skip its lock.
+		template <typename MutexType>
+		friend class ElidableMutex;
+
+		/**
+		 *  @brief  The ElidedLock struct stores a lock skipped by the main thread.
+		 */
+		struct ElidedLock {
+			ElidableMutexBase* mutex; ///< The mutex skipped.
+			bool shared;              ///< Whether the lock skipped is a shared one.
+		};
+
+		/**
+		 *  @brief  The User struct makes the thread owning it a user of the library until its end, see join.
+		 */
+		struct User {
+			bool joined = false; ///< Whether the thread has joined.
+
+			/**
+			 *  @brief  Destructor, declares the end of the use, if joined.
+			 */
+			~User();
+		};
+
+		/**
+		 *  @brief  The elide static method skips a lock, if allowed. Any thread other than the main one joins the users
+		 * and waits for the main thread to leave the sections of the mutex whose lock it skipped.
+		 *  @param mutex  The mutex to lock.
+		 *  @param shared true for a shared lock, false for an exclusive one.
+		 *  @return true if skipped, false if the mutex must be locked.
+		 */
+		static bool elide(ElidableMutexBase* mutex, const bool shared = false);
+
+		/**
+		 *  @brief  The tryElide static method skips an exclusive lock, if allowed, without waiting.
+		 *  @param mutex  The mutex to lock.
+		 *  @param elided Set to true if skipped, false if the mutex must be locked.
+		 *  @return false if the main thread is in a section of the mutex whose lock it skipped, true otherwise.
+		 */
+		static bool tryElide(ElidableMutexBase* mutex, bool& elided);
+
+		/**
+		 *  @brief  The unelide static method ends a lock skipped by elide.
+		 *  @param mutex  The mutex to unlock.
+		 *  @param shared true for a shared lock, false for an exclusive one.
+		 *  @return true if the lock was skipped, false if the mutex must be unlocked.
+		 */
+		static bool unelide(ElidableMutexBase* mutex, const bool shared = false);
+
+		/**
+		 *  @brief  The join static method makes the calling thread a user of the library until its end, switching
+		 * concurrency on.
+		 */
+		static void join();
+
+		/**
+		 *  @brief  The wait static method waits for the main thread to leave the sections of a mutex whose lock it
+		 * skipped, conflicting with the lock requested.
+		 *  @param mutex  The mutex to lock.
+		 *  @param shared true for a shared lock, false for an exclusive one.
+		 */
+		static void wait(ElidableMutexBase* mutex, const bool shared);
+
+		/**
+		 *  @brief  Flag telling whether the locks are being acquired.
+		 */
+		static std::atomic<bool> active;
+
+		/**
+		 *  @brief  The number of users declared with enable, or joined, and not yet ended.
+		 */
+		static std::atomic<size_t> users;
+
+		/**
+		 *  @brief  The main thread, see setMainThread.
+		 */
+		static std::thread::id mainThreadID;
+
+		/**
+		 *  @brief  The mutex guarding waitCondition.
+		 */
+		static std::mutex waitMutex;
+
+		/**
+		 *  @brief  The condition variable notified when the main thread leaves a section whose lock it skipped, while
+		 * concurrency is active.
+		 */
+		static std::condition_variable waitCondition;
+
+		/**
+		 *  @brief  The locks skipped by the calling thread, i.e. the main one, innermost last.
+		 */
+		static thread_local std::vector<ElidedLock> elidedLocks;
+
+		/**
+		 *  @brief  The use of the library by the calling thread, see join.
+		 */
+		static thread_local User user;
+	};
+
+	/**
+	 *  @brief  The ShardedRecursiveMutex class is a recursive reader-writer mutex made of a fixed number of recursive
+	 * mutexes, each on its own cache line. A shared lock locks only the shard of the calling thread, so that readers on
+	 * different shards never touch the same memory, while an exclusive lock locks all the shards, in order.
+	 *  @note   It suits read-mostly data looked up by many threads. A thread holding a shared lock must not lock
+	 * exclusively, while a thread holding an exclusive lock may lock both ways.
+	 */
+	class ShardedRecursiveMutex {
+	  public:
+		/**
+		 *  @brief  The number of shards.
+		 */
+		static const size_t ShardCount = 16;
+
+		/**
+		 *  @brief  The lock method locks all the shards, for writing.
+		 */
+		void lock();
+
+		/**
+		 *  @brief  The unlock method unlocks all the shards.
+		 */
+		void unlock();
+
+		/**
+		 *  @brief  The lock_shared method locks the shard of the calling thread, for reading.
+		 */
+		void lock_shared();
+
+		/**
+		 *  @brief  The unlock_shared method unlocks the shard of the calling thread.
+		 */
+		void unlock_shared();
+
+	  private:
+		/**
+		 *  @brief  The Shard struct pads a mutex to a cache line, so that shards locked by different threads do not
+		 * share it.
+		 */
+		struct alignas(64) Shard {
+			std::recursive_mutex mutex; ///< The mutex.
+		};
+
+		/**
+		 *  @brief  The getShardIndex static method returns the shard of the calling thread, assigned round robin at its
+		 * first lock.
+		 *  @return The index of the shard.
+		 */
+		static size_t getShardIndex();
+
+		/**
+		 *  @brief  The shards.
+		 */
+		Shard shards[ShardCount];
+	};
+
+	/**
+	 *  @brief  The SharedLockGuard class holds a shared lock of a mutex for its lifetime, as std::lock_guard does for
+	 * an exclusive one.
+	 */
+	template <typename MutexType>
+	class SharedLockGuard {
+	  public:
+		/**
+		 *  @brief  Constructor, locks the mutex for reading.
+		 *  @param mutex The mutex to lock.
+		 */
+		explicit SharedLockGuard(MutexType& mutex) : mutex(mutex) { this->mutex.lock_shared(); }
+
+		/**
+		 *  @brief  Destructor, unlocks the mutex.
+		 */
+		~SharedLockGuard() { mutex.unlock_shared(); }
+
+		SharedLockGuard(const SharedLockGuard&) = delete;
+		SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+
+	  private:
+		/**
+		 *  @brief  The mutex locked.
+		 */
+		MutexType& mutex;
+	};
+
+	/**
+	 *  @brief  The ElidableMutexBase class counts the locks of an ElidableMutex skipped by the main thread, which the
+	 * other threads wait for.
+	 */
+	class ElidableMutexBase {
+	  public:
+		/**
+		 *  @brief  Default constructor.
+		 */
+		ElidableMutexBase() : exclusiveElisions(0), sharedElisions(0) {}
+
+		ElidableMutexBase(const ElidableMutexBase&) = delete;
+		ElidableMutexBase& operator=(const ElidableMutexBase&) = delete;
+
+	  protected:
+		// The Concurrency is friend for letting it count the locks skipped.
+		friend class Concurrency;
+
+		/**
+		 *  @brief  The number of exclusive locks skipped by the main thread and not yet ended.
+		 */
+		std::atomic<size_t> exclusiveElisions;
+
+		/**
+		 *  @brief  The number of shared locks skipped by the main thread and not yet ended.
+		 */
+		std::atomic<size_t> sharedElisions;
+	};
+
+	/**
+	 *  @brief  The ElidableMutex class wraps a mutex which is not locked by the main thread while concurrency is not
+	 * active, see Concurrency. It can be used with std::lock_guard and std::unique_lock like the mutex wrapped, and
+	 * with SharedLockGuard if the mutex wrapped supports shared locks.
+	 */
+	template <typename MutexType>
+	class ElidableMutex : public ElidableMutexBase {
+	  public:
+		/**
+		 *  @brief  The lock method locks the mutex, unless the lock can be skipped.
+		 */
+		void lock() {
+			if (!Concurrency::elide(this))
+				mutex.lock();
+		}
+
+		/**
+		 *  @brief  The try_lock method tries to lock the mutex, unless the lock can be skipped.
+		 *  @return true if locked or skipped, false otherwise.
+		 */
+		bool try_lock() {
+			bool elided;
+			return Concurrency::tryElide(this, elided) && (elided || mutex.try_lock());
+		}
+
+		/**
+		 *  @brief  The unlock method unlocks the mutex, unless the lock was skipped.
+		 */
+		void unlock() {
+			if (!Concurrency::unelide(this))
+				mutex.unlock();
+		}
+
+		/**
+		 *  @brief  The lock_shared method locks the mutex for reading, unless the lock can be skipped.
+		 */
+		void lock_shared() {
+			if (!Concurrency::elide(this, true))
+				mutex.lock_shared();
+		}
+
+		/**
+		 *  @brief  The unlock_shared method unlocks the mutex for reading, unless the lock was skipped.
+		 */
+		void unlock_shared() {
+			if (!Concurrency::unelide(this, true))
+				mutex.unlock_shared();
+		}
+
+	  private:
+		/**
+		 *  @brief  The mutex wrapped.
+		 */
+		MutexType mutex;
+	};
+
+	/**
+	 *  @brief  The ElidableRecursiveMutex is an ElidableMutex wrapping a std::recursive_mutex.
+	 */
+	using ElidableRecursiveMutex = ElidableMutex<std::recursive_mutex>;
+
+	/**
+	 *  @brief  The ElidableShardedMutex is an ElidableMutex wrapping a ShardedRecursiveMutex.
+	 */
+	using ElidableShardedMutex = ElidableMutex<ShardedRecursiveMutex>;
+
+}
+#endif
+
+#endif
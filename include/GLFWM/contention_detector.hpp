@@ -0,0 +1,112 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_CONTENTION_DETECTOR_HPP
+#define GLFWM_CONTENTION_DETECTOR_HPP
+
+#include <GLFWM/enums.hpp>
+#ifndef NO_MULTITHREADING
+#include <atomic>
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The ContentionDetector class records the waits of a WindowGroup for the context of a Window while it is
+	 * held by another group. Windows sharing their contexts share also a mutex, so spreading them among groups running
+	 * concurrently makes the groups serialize.
+	 */
+	class ContentionDetector {
+	  public:
+		/**
+		 *  @brief  The Report struct summarizes the waits of a group for the contexts of a share group held by another
+		 * group.
+		 */
+		struct Report {
+			size_t contextShareID;         ///< The share group of the contexts, see Window::getContextShareID.
+			WindowGroupID waitingGroupID;  ///< The group that waited, or NoWindowGroupID for ungrouped drawing/events.
+			WindowGroupID owningGroupID;   ///< The group that held the contexts, or NoWindowGroupID.
+			unsigned long long waitCount;  ///< The number of waits.
+			double waitTime;               ///< The total time waited, in seconds.
+		};
+
+		/**
+		 *  @brief  The enable static method starts recording the waits.
+		 */
+		static void enable();
+
+		/**
+		 *  @brief  The disable static method stops recording the waits.
+		 */
+		static void disable();
+
+		/**
+		 *  @brief  The isEnabled static method says if the waits are being recorded.
+		 *  @return true if recording, false otherwise.
+		 */
+		static bool isEnabled();
+
+		/**
+		 *  @brief  The getReports static method returns the waits recorded so far.
+		 *  @param reports The list of reports, one for each share group and pair of groups.
+		 */
+		static void getReports(std::vector<Report>& reports);
+
+		/**
+		 *  @brief  The reset static method discards the waits recorded so far.
+		 */
+		static void reset();
+
+		/**
+		 *  @brief  The setCurrentGroup static method sets the group whose Windows the calling thread is drawing.
+		 *  @param id The ID of the group, or NoWindowGroupID.
+		 *  @return The ID of the group previously set.
+		 */
+		static WindowGroupID setCurrentGroup(const WindowGroupID id);
+
+		/**
+		 *  @brief  The getCurrentGroup static method returns the group whose Windows the calling thread is drawing.
+		 *  @return The ID of the group, or NoWindowGroupID.
+		 */
+		static WindowGroupID getCurrentGroup();
+
+		/**
+		 *  @brief  The recordWait static method records a wait for the contexts of a share group.
+		 *  @param contextShareID The share group of the contexts.
+		 *  @param owningGroupID  The group that held the contexts.
+		 *  @param waitTime       The time waited, in seconds.
+		 *  @note   Waits between threads drawing for the same group are not recorded. A warning is printed the first
+		 * time a pair of groups contend for a share group.
+		 */
+		static void recordWait(const size_t contextShareID, const WindowGroupID owningGroupID, const double waitTime);
+
+	  private:
+		/**
+		 *  @brief  Flag telling whether the waits are being recorded.
+		 */
+		static std::atomic<bool> enabled;
+
+		/**
+		 *  @brief  The reports, keyed by share group, waiting group and owning group.
+		 */
+		static std::map<std::tuple<size_t, WindowGroupID, WindowGroupID>, Report> reports;
+
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+		 */
+		static std::mutex globalMutex;
+	};
+
+}
+#endif
+
+#endif
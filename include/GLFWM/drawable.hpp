@@ -18,6 +18,17 @@
 
 namespace glfwm {
 
+	/**
+	 *    @brief  The FrameInfo struct describes the frame a Drawable is prepared for, see Drawable::prepare.
+	 */
+	struct FrameInfo {
+		WindowGroupID groupID;                      ///< The group drawing the frame, or NoWindowGroupID for the
+		                                            ///< main loop.
+		unsigned long long frameIndex;              ///< The number of frames drawn by the group before this one.
+		std::chrono::steady_clock::time_point time; ///< When the frame has started.
+		FrameInfo() : groupID(NoWindowGroupID), frameIndex(0), time(std::chrono::steady_clock::now()) {}
+	};
+
 	/// The Drawable class represents objects that can be rendered in a window. Inherit this class and bind its objects
 	/// to a window to be displayed.
 	class Drawable {
@@ -32,12 +43,138 @@ namespace glfwm {
 		 * to locate resources associated to it, e.g. OpenGL buffer objects.
 		 */
 		virtual void draw(const WindowID id) = 0;
+
+		/**
+		 *    @brief  The prepare method performs the CPU side work of a frame (e.g. culling, building buffers, laying
+		 * text out) before the frame is drawn. It is called only if hasPrepare returns true.
+		 *    @param id    The ID of the window going to be drawn.
+		 *    @param frame The frame going to be drawn.
+		 *    @note   The windows to draw in a frame are prepared in parallel, on the Executor, before any of them is
+		 * drawn: no context is current, and this may run concurrently with the prepare of other windows, and with the
+		 * event handlers of the main thread. See PreparedDrawable for handing the data prepared over to draw.
+		 */
+		virtual void prepare(const WindowID /*id*/, const FrameInfo& /*frame*/) {}
+
+		/**
+		 *    @brief  The hasPrepare method says if prepare has to be called before each frame. It must not change
+		 * while this Drawable is bound to a window.
+		 *    @return true if this Drawable implements prepare, false otherwise (the default).
+		 */
+		virtual bool hasPrepare() const { return false; }
 	};
 
 	/**
 	 *    @brief  A smart pointer to a Drawable. To bind a Drawable to a Window, a smart pointer must be used.
 	 */
 	using DrawablePointer = std::shared_ptr<Drawable>;
+
+	/**
+	 *    @brief  The PreparedDrawable class is a Drawable whose frames are built in two phases: prepareData fills, in
+	 * parallel with the other windows, the data of a window, which drawData then renders with the context current. It
+	 * keeps one DataType object per window, reused frame after frame.
+	 *    @note   The data of a window is prepared only after the previous frame of the window has been drawn, and drawn
+	 * only after it has been prepared: a window drawn outside of a frame (e.g. by calling Window::draw directly) is
+	 * prepared right before, on the calling thread.
+	 */
+	template <typename DataType>
+	class PreparedDrawable : public Drawable {
+	  public:
+		/**
+		 *    @brief  The draw method renders the data prepared for the window, preparing it first if needed.
+		 *    @param id The ID of the window calling this method at a given time.
+		 */
+		void draw(const WindowID id) override {
+			Slot& s = getSlot(id);
+			if (!s.prepared)
+				prepareData(id, FrameInfo(), s.data);
+			s.prepared = false;
+			drawData(id, s.data);
+		}
+
+		/**
+		 *    @brief  The prepare method prepares the data of the window.
+		 *    @param id    The ID of the window going to be drawn.
+		 *    @param frame The frame going to be drawn.
+		 */
+		void prepare(const WindowID id, const FrameInfo& frame) override {
+			Slot& s = getSlot(id);
+			prepareData(id, frame, s.data);
+			s.prepared = true;
+		}
+
+		/**
+		 *    @brief  The hasPrepare method says that prepare has to be called before each frame.
+		 *    @return true.
+		 */
+		bool hasPrepare() const override { return true; }
+
+		/**
+		 *    @brief  The releaseData method destroys the data of a window, e.g. after unbinding this Drawable from it.
+		 *    @param id The ID of the window.
+		 *    @note   It must not be called while the window is being prepared or drawn.
+		 */
+		void releaseData(const WindowID id) {
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(mutex);
+#endif
+			slots.erase(id);
+		}
+
+	  protected:
+		/**
+		 *    @brief  The prepareData method fills the data to draw in a window. It must be implemented in derived
+		 * classes, and it must not use the context, see Drawable::prepare.
+		 *    @param id    The ID of the window going to be drawn.
+		 *    @param frame The frame going to be drawn.
+		 *    @param data  The data of the window, as left by the previous frame.
+		 */
+		virtual void prepareData(const WindowID id, const FrameInfo& frame, DataType& data) = 0;
+
+		/**
+		 *    @brief  The drawData method renders the data prepared for a window, with its context current. It must be
+		 * implemented in derived classes.
+		 *    @param id   The ID of the window calling this method at a given time.
+		 *    @param data The data prepared by prepareData.
+		 */
+		virtual void drawData(const WindowID id, DataType& data) = 0;
+
+	  private:
+		/**
+		 *    @brief  The Slot struct stores the data of a window.
+		 */
+		struct Slot {
+			DataType data; ///< The data.
+			bool prepared; ///< Whether the data has been prepared for the next draw.
+			Slot() : data(), prepared(false) {}
+		};
+
+		/**
+		 *    @brief  The getSlot method returns the slot of a window, creating it at the first use.
+		 *    @param id The ID of the window.
+		 *    @return The slot, whose address does not change until releaseData.
+		 */
+		Slot& getSlot(const WindowID id) {
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(mutex);
+#endif
+			return slots[id];
+		}
+
+		/**
+		 *    @brief  The slots of the windows. Each one is used by a single thread at a time, the one preparing or
+		 * drawing the window, so only the map is guarded.
+		 */
+		std::unordered_map<WindowID, Slot> slots;
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *    @brief  Mutex used to guarantee correct concurrent management of slots.
+		 */
+		std::mutex mutex;
+#endif
+	};
 }
 
 #endif
@@ -369,6 +369,22 @@ namespace glfwm {
 	    | EventType::CURSOR_ENTER | EventType::CURSOR_POSITION | EventType::DROP | EventType::KEY
 	    | EventType::MOUSE_BUTTON | EventType::SCROLL;
 
+	/**
+	 *  @brief  ThreadPriorityBaseType is the base type used to identify the scheduling priorities of threads.
+	 */
+	using ThreadPriorityBaseType = int;
+
+	/**
+	 *  @brief  The ThreadPriority enum represents the scheduling priorities that can be requested for the threads
+	 * running the loops of WindowGroups.
+	 */
+	enum class ThreadPriority : ThreadPriorityBaseType {
+		PRIORITY_LOW,      ///< Background work, e.g. nice level 10 on Linux.
+		PRIORITY_NORMAL,   ///< The default priority of the system.
+		PRIORITY_HIGH,     ///< Latency-sensitive work, e.g. nice level -10 on Linux (it may require privileges).
+		PRIORITY_REALTIME  ///< Real-time FIFO scheduling, where supported (it usually requires privileges).
+	};
+
 }
 
 #endif
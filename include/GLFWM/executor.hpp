@@ -0,0 +1,239 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_EXECUTOR_HPP
+#define GLFWM_EXECUTOR_HPP
+
+#include <GLFWM/thread_options.hpp>
+#ifndef NO_MULTITHREADING
+#include <atomic>
+#include <functional>
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The Executor class represents a pool of worker threads shared by all the WindowGroups whose loop runs
+	 * as a sequence of tasks rather than on a dedicated thread. Each worker owns a queue of tasks and, when its own
+	 * queue is empty, steals tasks from the others.
+	 */
+	class Executor {
+	  public:
+		/**
+		 *  @brief  The Task is the type of the units of work executed by the worker threads.
+		 */
+		using Task = std::function<void()>;
+
+		/**
+		 *  @brief  The TimePoint is the type of the instants at which delayed tasks are due.
+		 */
+		using TimePoint = std::chrono::steady_clock::time_point;
+
+		/**
+		 *  @brief  The TimedTaskID is the type of the IDs identifying delayed tasks, used to cancel them.
+		 */
+		using TimedTaskID = size_t;
+
+		/**
+		 *  @brief  The start static method starts the worker threads, if not yet started.
+		 *  @param threadCount The number of worker threads. 0 means as many as the hardware concurrency.
+		 *  @note   It is not necessary to call this method: submit starts the workers when needed.
+		 */
+		static void start(const size_t threadCount = 0);
+
+		/**
+		 *  @brief  The stop static method stops and joins the worker threads. The tasks not yet executed are discarded.
+		 *  @note   The WindowGroups running on this Executor stop drawing, and can be stopped afterwards, as can be the
+		 * LoadBalancer, which must be enabled again.
+		 */
+		static void stop();
+
+		/**
+		 *  @brief  The isRunning static method says if the worker threads have been started.
+		 *  @return true if the workers are running, false otherwise.
+		 */
+		static bool isRunning();
+
+		/**
+		 *  @brief  The getRunCount static method returns how many times the worker threads have been started, so that
+		 * the owners of tasks can tell whether a stop has discarded them meanwhile.
+		 *  @return The number of starts.
+		 */
+		static size_t getRunCount();
+
+		/**
+		 *  @brief  The getThreadCount static method returns the number of worker threads currently running.
+		 *  @return The number of worker threads.
+		 */
+		static size_t getThreadCount();
+
+		/**
+		 *  @brief  The submit static method queues a task to be executed by one of the worker threads.
+		 *  @param task The task to execute.
+		 *  @note   If called from a worker thread, the task is queued to that worker, otherwise the workers are chosen
+		 * in round-robin. Idle workers steal queued tasks from busy ones.
+		 */
+		static void submit(Task task);
+
+		/**
+		 *  @brief  The submitAt static method queues a task to be executed by one of the worker threads not before a
+		 * given time.
+		 *  @param time The time at which the task is due.
+		 *  @param task The task to execute.
+		 *  @return The ID of the delayed task, which can be used to cancel it.
+		 */
+		static TimedTaskID submitAt(const TimePoint& time, Task task);
+
+		/**
+		 *  @brief  The cancel static method removes a delayed task, if not yet started.
+		 *  @param id The ID of the delayed task to cancel.
+		 *  @return true if the task has been removed, false if it has already been started or it does not exist.
+		 */
+		static bool cancel(const TimedTaskID id);
+
+		/**
+		 *  @brief  The parallelFor static method runs a function for each index in [0, count) on the worker threads,
+		 * the calling thread included, and returns when all the calls have returned.
+		 *  @param count The number of indices.
+		 *  @param job   The function, called once per index, possibly concurrently.
+		 *  @note   The calling thread takes indices too, so this may be called from a task and completes even if the
+		 * workers are busy. The first exception thrown by the function is rethrown, after all the calls have
+		 * returned.
+		 */
+		static void parallelFor(const size_t count, const std::function<void(size_t)>& job);
+
+	  private:
+		/**
+		 *  @brief  The Worker struct stores the queue of tasks of a worker thread.
+		 */
+		struct Worker {
+			std::deque<Task> tasks;
+			std::mutex mutex;
+		};
+
+		/**
+		 *  @brief  The ParallelFor struct stores the state of a call to parallelFor, shared with the tasks helping it.
+		 */
+		struct ParallelFor {
+			std::function<void(size_t)> job;  ///< The function to call for each index.
+			size_t count;                     ///< The number of indices.
+			std::atomic<size_t> next;         ///< The next index to take.
+			std::atomic<size_t> done;         ///< The number of calls returned.
+			std::exception_ptr error;         ///< The first exception thrown by the function.
+			std::mutex mutex;                 ///< Guards error and the waiting for the calls.
+			std::condition_variable finished; ///< Notified when all the calls have returned.
+			ParallelFor() : count(0), next(0), done(0) {}
+		};
+
+		/**
+		 *  @brief  The startWorkers static method starts the worker threads, if not yet started. To be called while
+		 * holding globalMutex.
+		 *  @param threadCount The number of worker threads. 0 means as many as the hardware concurrency.
+		 */
+		static void startWorkers(const size_t threadCount);
+
+		/**
+		 *  @brief  The runParallelFor static method takes the indices of a call to parallelFor until none is left.
+		 *  @param p The state of the call.
+		 */
+		static void runParallelFor(ParallelFor& p);
+
+		/**
+		 *  @brief  The workerLoop static method is the function executed by each worker thread.
+		 *  @param index The index of the worker.
+		 */
+		static void workerLoop(const size_t index);
+
+		/**
+		 *  @brief  The popTask static method takes the next task of the worker at index, or steals one from another
+		 * worker.
+		 *  @param index The index of the worker looking for a task.
+		 *  @param task  The output task.
+		 *  @return true if a task has been found, false otherwise.
+		 */
+		static bool popTask(const size_t index, Task& task);
+
+		/**
+		 *  @brief  The popTimedTask static method takes the first delayed task, if due.
+		 *  @param task The output task.
+		 *  @return true if a due task has been found, false otherwise.
+		 */
+		static bool popTimedTask(Task& task);
+
+		/**
+		 *  @brief  The TimedTask struct stores a delayed task together with its ID.
+		 */
+		struct TimedTask {
+			TimedTaskID id;
+			Task task;
+		};
+
+		/**
+		 *  @brief  The delayed tasks, sorted by the time they are due.
+		 */
+		static std::multimap<TimePoint, TimedTask> timedTasks;
+
+		/**
+		 *  @brief  The number of delayed tasks, used to avoid locking when there are none.
+		 */
+		static std::atomic<size_t> timedTaskCount;
+
+		/**
+		 *  @brief  The ID of the next delayed task.
+		 */
+		static TimedTaskID nextTimedTaskID;
+
+		/**
+		 *  @brief  The queues of the worker threads.
+		 */
+		static std::vector<std::unique_ptr<Worker>> workers;
+
+		/**
+		 *  @brief  The worker threads.
+		 */
+		static std::vector<std::thread> threads;
+
+		/**
+		 *  @brief  The number of tasks queued and not yet taken by any worker.
+		 */
+		static std::atomic<size_t> pendingTasks;
+
+		/**
+		 *  @brief  The index of the next worker to queue a task submitted from outside the pool.
+		 */
+		static std::atomic<size_t> nextWorker;
+
+		/**
+		 *  @brief  Flag used to continue/break the execution of the worker threads.
+		 */
+		static std::atomic<bool> doRun;
+
+		/**
+		 *  @brief  The number of times the worker threads have been started.
+		 */
+		static std::atomic<size_t> runCount;
+
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+		 */
+		static std::mutex globalMutex;
+
+		/**
+		 *  @brief  Condition Variable used by idle workers to wait for tasks.
+		 */
+		static std::condition_variable conditionVariable;
+	};
+
+}
+#endif
+
+#endif
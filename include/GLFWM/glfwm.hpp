@@ -14,19 +14,53 @@
 #ifndef GLFWM_HPP
 #define GLFWM_HPP
 
+#include <GLFWM/window_config.hpp>
 #include <GLFWM/window_group.hpp>
+#include <exception>
+#include <functional>
+#ifndef NO_MULTITHREADING
+#include <future>
+#endif
 
 namespace glfwm {
 
 	/// The WindowManager class provides static methods for managing Windows, Groups, Events and the loop.
 	class WindowManager {
 	  public:
+		/**
+		 *  @brief  The Task is the type of the functions run by the main thread, see post.
+		 */
+		using Task = std::function<void()>;
+
+		/**
+		 *  @brief  The WindowCallback is the type of the functions receiving a Window created asynchronously, see
+		 * createWindowAsync.
+		 */
+		using WindowCallback = std::function<void(const WindowPointer&)>;
+
+		/**
+		 *  @brief  The WindowsCallback is the type of the functions receiving the Windows created asynchronously, see
+		 * createWindowsAsync.
+		 */
+		using WindowsCallback = std::function<void(const std::vector<WindowPointer>&)>;
+
 		/**
 		 *    @brief   The init static method initializes GLFW.
 		 *    @return true if correctly initialized, false otherwise.
 		 */
 		static bool init();
 
+		/**
+		 *  @brief  The init static method initializes GLFW and the WindowPool, creating some hidden windows to be
+		 * recycled by the first Windows created.
+		 *  @param windowPoolCapacity The maximum number of GLFW windows kept for recycling, see WindowPool.
+		 *  @param warmUpConfigs      The configurations of the windows to create, one each (repeat a configuration for
+		 * several windows). Those fullscreen, sharing their context or in excess of the capacity are not created.
+		 *  @return true if correctly initialized, false otherwise.
+		 */
+		static bool init(const size_t windowPoolCapacity,
+		                 const std::vector<WindowConfig>& warmUpConfigs = std::vector<WindowConfig>());
+
 		/**
 		 *    @brief  The setSwapInterval static method changes the number of screen updates to wait before swapping the
 		 * framebuffers (vsync).
@@ -79,6 +113,8 @@ namespace glfwm {
 		 *    @param monitor    A pointer to a monitor for fullscreen, or NULL otherwise.
 		 *    @param share      A pointer to another window to share its context with, or NULL otherwise.
 		 *    @return A pointer to the new created Window.
+		 *    @note   The window is recycled from the WindowPool if possible, assuming the hints have been set with
+		 * setHint.
 		 */
 		static WindowPointer createWindow(const int width,
 		                                  const int height,
@@ -105,11 +141,64 @@ namespace glfwm {
 		                                  GLFWmonitor* monitor = nullptr,
 		                                  const WindowPointer& share = WindowPointer(nullptr));
 
+		/**
+		 *  @brief  The createWindow static method constructs a new Window as configured, hints included, and registers
+		 * its callbacks.
+		 *  @param config The configuration of the window.
+		 *  @return A pointer to the new created Window.
+		 *  @note   This may only be called from the main thread. The hints set with setHint are restored afterwards.
+		 */
+		static WindowPointer createWindow(const WindowConfig& config);
+
+		/**
+		 *  @brief  The createWindowAsync static method requests the main thread to create a new Window as configured,
+		 * see createWindow, and returns immediately. It may be called from any thread.
+		 *  @param config   The configuration of the window.
+		 *  @param callback The function called from the main thread with the new Window, or with a null pointer if it
+		 * could not be created (a warning is printed). It may be empty.
+		 *  @note   The requests are batched: all those pending are served by a single iteration of mainLoop, setting
+		 * the hints only when they change from a window to the next. If called from the main thread, the window is
+		 * created immediately.
+		 */
+		static void createWindowAsync(const WindowConfig& config, const WindowCallback& callback);
+
+		/**
+		 *  @brief  The createWindowsAsync static method requests the main thread to create several new Windows
+		 * together, see createWindowAsync.
+		 *  @param configs  The configurations of the windows.
+		 *  @param callback The function called from the main thread with the new Windows, in the order of configs, null
+		 * for those which could not be created (a warning is printed). It may be empty.
+		 */
+		static void createWindowsAsync(const std::vector<WindowConfig>& configs, const WindowsCallback& callback);
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  The createWindowAsync static method requests the main thread to create a new Window as configured,
+		 * see createWindow, and returns immediately. It may be called from any thread.
+		 *  @param config The configuration of the window.
+		 *  @return The future Window, or the exception thrown creating it.
+		 *  @note   See createWindowAsync with a callback.
+		 */
+		static std::future<WindowPointer> createWindowAsync(const WindowConfig& config);
+
+		/**
+		 *  @brief  The createWindowsAsync static method requests the main thread to create several new Windows
+		 * together, see createWindowAsync.
+		 *  @param configs The configurations of the windows.
+		 *  @return The future Windows, in the order of configs, null for those which could not be created (a warning
+		 * is printed).
+		 */
+		static std::future<std::vector<WindowPointer>> createWindowsAsync(const std::vector<WindowConfig>& configs);
+#endif
+
 		/**
 		 *    @brief  The registerWindowCallbacks static method sets callbacks for window to handle events of type
 		 * eventTypes.
 		 *    @param window     The Window whose events must be handled with the callbacks to register.
 		 *    @param eventTypes A mask corresponding to the list of event types to register for callbacks.
+		 *    @note   The callbacks of position, size, focus, maximization, iconification, framebuffer size and content
+		 * scale are registered anyway, as they keep the properties cached by the window up to date (see
+		 * Window::getState), but their events are handled only if in eventTypes.
 		 */
 		static void registerWindowCallbacks(WindowPointer& window, const EventBaseType eventTypes = allEventTypes);
 
@@ -139,6 +228,59 @@ namespace glfwm {
 		 */
 		static void terminate();
 
+		/**
+		 *  @brief  The isMainThread static method says if the calling thread is the main thread, i.e. the one which
+		 * called init.
+		 *  @return true if called from the main thread, false otherwise.
+		 */
+		static bool isMainThread();
+
+		/**
+		 *  @brief  The post static method queues a function to be run by the main thread during mainLoop, and returns
+		 * immediately. It may be called from any thread, e.g. for the GLFW functions restricted to the main thread.
+		 *  @param task The function to run.
+		 *  @note   The functions are run in the order they are posted, at most getMaxTasksPerIteration per iteration of
+		 * mainLoop. Exceptions thrown by them are reported as warnings. Those left when terminating are discarded.
+		 */
+		static void post(Task task);
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  The invoke static method runs a function in the main thread, see post, and gives its result.
+		 *  @param function The function to run, taking no arguments.
+		 *  @return The future result of the function, or of the exception it throws.
+		 *  @note   If called from the main thread, the function is run immediately, as waiting for a result from mainLoop
+		 * would never return.
+		 */
+		template <typename F>
+		static std::future<typename std::result_of<F()>::type> invoke(F function) {
+			using ResultType = typename std::result_of<F()>::type;
+			std::shared_ptr<std::packaged_task<ResultType()>> task = std::make_shared<std::packaged_task<ResultType()>>(
+			    std::move(function));
+			std::future<ResultType> result = task->get_future();
+			if (isMainThread())
+				(*task)();
+			else
+				post([task]() { (*task)(); });
+			return result;
+		}
+#endif
+
+		/**
+		 *  @brief  The setMaxTasksPerIteration static method bounds the number of posted functions run by each
+		 * iteration of mainLoop, so that a burst of them does not delay event handling. The others are left for the
+		 * next iterations.
+		 *  @param count The maximum number of functions per iteration. The default is 64.
+		 */
+		static void setMaxTasksPerIteration(const size_t count);
+
+		/**
+		 *  @brief  The getMaxTasksPerIteration static method returns the number of posted functions run by each
+		 * iteration of mainLoop at most.
+		 *  @return The maximum number of functions per iteration.
+		 */
+		static size_t getMaxTasksPerIteration();
+
 	  private:
 		// callbacks
 		static void windowPositionCallback(GLFWwindow* glfwWindow, int x, int y);
@@ -159,6 +301,65 @@ namespace glfwm {
 		static void inputCharModCallback(GLFWwindow* glfwWindow, unsigned int codepoint, int mods);
 		static void inputDropCallback(GLFWwindow* glfwWindow, int count, const char** paths);
 
+		/**
+		 *  @brief  The runPostedTasks static method runs the functions posted to the main thread, at most
+		 * maxTasksPerIteration.
+		 */
+		static void runPostedTasks();
+
+		/**
+		 *  @brief  The CreationRequest struct stores a request of creating Windows asynchronously.
+		 */
+		struct CreationRequest {
+			std::vector<WindowConfig> configs; ///< The configurations of the windows to create.
+			std::function<void(std::vector<WindowPointer>&, std::vector<std::exception_ptr>&)>
+			    done; ///< Called with the windows created, null if failed, and the exceptions thrown, null if none.
+		};
+
+		/**
+		 *  @brief  The requestWindows static method queues a request of creating Windows, and wakes up the main thread
+		 * to serve it.
+		 *  @param request The request.
+		 */
+		static void requestWindows(CreationRequest request);
+
+		/**
+		 *  @brief  The createRequestedWindows static method serves the pending requests of creating Windows.
+		 */
+		static void createRequestedWindows();
+
+		/**
+		 *  @brief  The serveRequests static method creates the Windows of some requests and then calls their functions.
+		 *  @param requests The requests.
+		 */
+		static void serveRequests(std::vector<CreationRequest>& requests);
+
+		/**
+		 *  @brief  The applyHints static method resets the window hints to their default values and then sets some.
+		 *  @param hints The hints to set.
+		 */
+		static void applyHints(const std::vector<WindowConfig::Hint>& hints);
+
+		/**
+		 *  @brief  The newManagedWindow static method constructs a new Window, recycled from the WindowPool if
+		 * possible, and registers its callbacks.
+		 *  @param width      The window width.
+		 *  @param height     The window height.
+		 *  @param title      The window title.
+		 *  @param eventTypes A mask corresponding to the list of event types to register for callbacks.
+		 *  @param monitor    A pointer to a monitor for fullscreen, or NULL otherwise.
+		 *  @param share      A pointer to another window to share its context with, or NULL otherwise.
+		 *  @param hints      The hints currently set, on top of the default ones.
+		 *  @return A pointer to the new created Window.
+		 */
+		static WindowPointer newManagedWindow(const int width,
+		                                      const int height,
+		                                      const std::string& title,
+		                                      const EventBaseType eventTypes,
+		                                      GLFWmonitor* monitor,
+		                                      const WindowPointer& share,
+		                                      const std::vector<WindowConfig::Hint>& hints);
+
 #ifndef NO_MULTITHREADING
 		static std::atomic<double> waitTimeout; ///< Timeout for the polling event management: 0 -> poll, inf -> wait
 		                                        ///< indefinitely, k -> wait k seconds.
@@ -166,6 +367,23 @@ namespace glfwm {
 		static double waitTimeout; ///< Timeout for the polling event management: 0 -> poll, inf -> wait indefinitely, k
 		                           ///< -> wait k seconds.
 #endif
+
+#ifndef NO_MULTITHREADING
+		static MPSCQueue<Task> postedTasks;              ///< The functions posted to the main thread.
+		static std::atomic<bool> tasksPosted;            ///< Whether the main loop has been woken up for them.
+		static std::atomic<size_t> maxTasksPerIteration; ///< The maximum number of them run per iteration.
+		static std::thread::id mainThreadID;             ///< The thread which called init.
+#else
+		static std::deque<Task> postedTasks;  ///< The functions posted to the main thread.
+		static bool tasksPosted;              ///< Whether the main loop has been woken up for them.
+		static size_t maxTasksPerIteration;   ///< The maximum number of them run per iteration.
+#endif
+
+		static std::vector<WindowConfig::Hint> globalHints;   ///< The hints set with setHint.
+		static std::vector<CreationRequest> creationRequests; ///< The pending requests of creating Windows.
+#ifndef NO_MULTITHREADING
+		static std::mutex creationMutex; ///< Guards creationRequests.
+#endif
 	};
 
 }
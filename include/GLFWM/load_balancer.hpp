@@ -0,0 +1,165 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_LOAD_BALANCER_HPP
+#define GLFWM_LOAD_BALANCER_HPP
+
+#include <GLFWM/executor.hpp>
+#ifndef NO_MULTITHREADING
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The LoadBalancer class periodically moves Windows between a pool of concurrent WindowGroups, so that
+	 * the CPU time spent drawing is spread evenly among their threads. The cost of each Window is measured with the
+	 * CPU clock of the thread drawing it. Windows sharing their contexts are always kept in the same group.
+	 *  @note   The moves are carried out by the source groups, before their next frame.
+	 */
+	class LoadBalancer {
+	  public:
+		/**
+		 *  @brief  The Decision struct describes a move of Windows from a group to another.
+		 */
+		struct Decision {
+			std::chrono::steady_clock::time_point time; ///< When the move has been decided.
+			std::vector<WindowID> windowIDs;            ///< The Windows moved, sharing their contexts.
+			WindowGroupID fromGroupID;                  ///< The group the Windows have been detached from.
+			WindowGroupID toGroupID;                    ///< The group the Windows have been attached to.
+			double load;                                ///< The load of the Windows, as a fraction of a CPU.
+			double fromGroupLoad;                       ///< The load of the source group before the move.
+			double toGroupLoad;                         ///< The load of the destination group before the move.
+		};
+
+		/**
+		 *  @brief  The enable static method starts balancing the Windows among a pool of WindowGroups.
+		 *  @param groupIDs The IDs of the groups in the pool, which should run their loops concurrently.
+		 *  @param interval The time between two balancing steps, in seconds.
+		 */
+		static void enable(const std::vector<WindowGroupID>& groupIDs, const double interval = 1.0);
+
+		/**
+		 *  @brief  The disable static method stops balancing and synchronizes with the end of any step in progress.
+		 */
+		static void disable();
+
+		/**
+		 *  @brief  The isEnabled static method says if the balancing is active.
+		 *  @return true if active, false otherwise.
+		 *  @note   Stopping the Executor discards the balancing steps: enable must be called again afterwards.
+		 */
+		static bool isEnabled();
+
+		/**
+		 *  @brief  The setThreshold static method changes the minimum difference of load between the most and the
+		 * least loaded groups for moving Windows.
+		 *  @param threshold The minimum difference, as a fraction of a CPU. The default is 0.1.
+		 */
+		static void setThreshold(const double threshold);
+
+		/**
+		 *  @brief  The balance static method measures the load of the groups in the pool and moves Windows from the
+		 * most to the least loaded ones. It is called periodically while enabled, but it can also be called directly.
+		 */
+		static void balance();
+
+		/**
+		 *  @brief  The getDecisions static method returns the most recent moves, oldest first.
+		 *  @param decisions The list of moves.
+		 */
+		static void getDecisions(std::deque<Decision>& decisions);
+
+		/**
+		 *  @brief  The getGroupLoads static method returns the last measured load of the groups in the pool.
+		 *  @param loads The map from the IDs of the groups to their loads, as fractions of a CPU.
+		 */
+		static void getGroupLoads(std::unordered_map<WindowGroupID, double>& loads);
+
+		/**
+		 *  @brief  The getThreadCPUTime static method returns the CPU time consumed so far by the calling thread.
+		 *  @return The CPU time, in seconds.
+		 *  @note   Where not supported, the wall-clock time is returned instead.
+		 */
+		static double getThreadCPUTime();
+
+	  private:
+		/**
+		 *  @brief  The timerTask static method is the delayed task executing the periodic balancing steps.
+		 *  @param taskGeneration The generation of the balancing the task belongs to.
+		 */
+		static void timerTask(const size_t taskGeneration);
+
+		/**
+		 *  @brief  Flag telling whether the balancing is active, read by the groups to measure their Windows.
+		 */
+		static std::atomic<bool> enabled;
+
+		/**
+		 *  @brief  The IDs of the groups in the pool.
+		 */
+		static std::vector<WindowGroupID> pool;
+
+		/**
+		 *  @brief  The time between two balancing steps, in seconds.
+		 */
+		static double interval;
+
+		/**
+		 *  @brief  The minimum difference of load between two groups for moving Windows.
+		 */
+		static double threshold;
+
+		/**
+		 *  @brief  The time of the last balancing step.
+		 */
+		static std::chrono::steady_clock::time_point lastBalance;
+
+		/**
+		 *  @brief  The smoothed load of each Window, as a fraction of a CPU.
+		 */
+		static std::unordered_map<WindowID, double> windowLoads;
+
+		/**
+		 *  @brief  The smoothed load of each group, as a fraction of a CPU.
+		 */
+		static std::unordered_map<WindowGroupID, double> groupLoads;
+
+		/**
+		 *  @brief  The most recent moves.
+		 */
+		static std::deque<Decision> decisions;
+
+		/**
+		 *  @brief  The ID of the pending delayed task executing the next balancing step.
+		 */
+		static Executor::TimedTaskID timerID;
+
+		/**
+		 *  @brief  The number of times the balancing has been enabled, used to identify the periodic tasks.
+		 */
+		static size_t generation;
+
+		/**
+		 *  @brief  The run of the Executor the pending balancing step has been submitted to, see Executor::getRunCount.
+		 */
+		static std::atomic<size_t> executorRun;
+
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+		 */
+		static std::mutex globalMutex;
+	};
+
+}
+#endif
+
+#endif
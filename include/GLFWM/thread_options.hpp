@@ -0,0 +1,61 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_THREAD_OPTIONS_HPP
+#define GLFWM_THREAD_OPTIONS_HPP
+
+#include <GLFWM/enums.hpp>
+#ifndef NO_MULTITHREADING
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The ThreadOptions class stores the name, the CPU affinity and the scheduling priority to apply to a
+	 * thread when it starts.
+	 */
+	class ThreadOptions {
+	  public:
+		/**
+		 *  @brief  Default constructor: no name, no CPU affinity and normal priority.
+		 */
+		ThreadOptions();
+
+		/**
+		 *  @brief  The applyToCurrentThread method sets the options to the calling thread, where supported by the
+		 * platform.
+		 *  @return true if all the options have been applied, false otherwise.
+		 *  @note   A warning is printed for every option that could not be applied.
+		 */
+		bool applyToCurrentThread() const;
+
+		/**
+		 *  @brief  The name of the thread, as shown by debuggers and profilers. Empty means not set.
+		 *  @note   Some platforms truncate it (e.g. 15 characters on Linux).
+		 */
+		std::string name;
+
+		/**
+		 *  @brief  The CPUs the thread is allowed to run on. Empty means any.
+		 */
+		std::vector<unsigned int> cpus;
+
+		/**
+		 *  @brief  The scheduling priority of the thread.
+		 */
+		ThreadPriority priority;
+	};
+
+}
+#endif
+
+#endif
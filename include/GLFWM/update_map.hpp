@@ -14,6 +14,7 @@
 #ifndef GLFWM_UPDATE_MAP_HPP
 #define GLFWM_UPDATE_MAP_HPP
 
+#include <GLFWM/concurrency.hpp>
 #include <GLFWM/enums.hpp>
 
 namespace glfwm {
@@ -34,6 +35,13 @@ namespace glfwm {
 		 */
 		static void notify(const WindowGroupID gID = AnyWindowGroupID, const WindowID wID = AllWindowIDs);
 
+		/**
+		 *  @brief  The notifyTag static method is used to wake up the WindowManager once and send a signal to all the
+		 * Windows labelled with a tag to update themselves.
+		 *  @param tag The tag of the Windows to update, see Window::addTag.
+		 */
+		static void notifyTag(const std::string& tag);
+
 	  private:
 		friend class WindowManager;
 
@@ -66,9 +74,10 @@ namespace glfwm {
 
 #ifndef NO_MULTITHREADING
 		/**
-		 *  @brief  Mutex used to guarantee exclusive access to the elements in the queue.
+		 *  @brief  Mutex used to guarantee exclusive access to the elements in the queue. It is skipped by the main
+		 * thread while concurrency is not active, see Concurrency.
 		 */
-		static std::mutex globalMutex;
+		static ElidableMutex<std::mutex> globalMutex;
 #endif
 	};
 }
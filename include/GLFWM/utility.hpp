@@ -15,6 +15,10 @@
 #define GLFWM_UTILITY_HPP
 
 #include <GLFWM/common.hpp>
+#ifndef NO_MULTITHREADING
+#include <atomic>
+#include <cstring>
+#endif
 
 namespace glfwm {
 
@@ -34,6 +38,420 @@ namespace glfwm {
 		bool operator<(const ObjectRank& r) const { return rank < r.rank; }
 	};
 
+	/**
+	 *  @brief  The DynamicBitset class is a set of small non-negative integers (e.g. IDs) stored as a growable array of
+	 * bits, so that unions and membership tests cost a few word operations.
+	 */
+	class DynamicBitset {
+	  public:
+		/**
+		 *  @brief  The value returned by findNext when there are no more bits set.
+		 */
+		static const size_t npos = static_cast<size_t>(-1);
+
+		/**
+		 *  @brief  The set method adds i to the set, growing it if needed.
+		 *  @param i The integer to add.
+		 */
+		void set(const size_t i) {
+			if (i / WordBits >= words.size())
+				words.resize(i / WordBits + 1, 0);
+			words[i / WordBits] |= Word(1) << (i % WordBits);
+		}
+
+		/**
+		 *  @brief  The reset method removes i from the set.
+		 *  @param i The integer to remove.
+		 */
+		void reset(const size_t i) {
+			if (i / WordBits < words.size())
+				words[i / WordBits] &= ~(Word(1) << (i % WordBits));
+		}
+
+		/**
+		 *  @brief  The test method says if i is in the set.
+		 *  @param i The integer to look for.
+		 *  @return true if i is in the set, false otherwise.
+		 */
+		bool test(const size_t i) const {
+			return i / WordBits < words.size() && (words[i / WordBits] >> (i % WordBits)) & Word(1);
+		}
+
+		/**
+		 *  @brief  The clear method removes all the integers, keeping the memory allocated.
+		 */
+		void clear() { std::fill(words.begin(), words.end(), Word(0)); }
+
+		/**
+		 *  @brief  The none method says if the set is empty.
+		 *  @return true if no integer is in the set, false otherwise.
+		 */
+		bool none() const {
+			for (auto w : words)
+				if (w)
+					return false;
+			return true;
+		}
+
+		/**
+		 *  @brief  The findNext method returns the smallest integer in the set not less than i.
+		 *  @param i The integer to start from.
+		 *  @return The integer found, or npos.
+		 */
+		size_t findNext(size_t i) const {
+			while (i / WordBits < words.size()) {
+				const Word w = words[i / WordBits] >> (i % WordBits);
+				if (!w) {
+					i = (i / WordBits + 1) * WordBits;
+					continue;
+				}
+				for (Word b = w; !(b & Word(1)); b >>= 1)
+					++i;
+				return i;
+			}
+			return npos;
+		}
+
+		/**
+		 *  @brief  The overloaded operator |= adds all the integers of another set.
+		 *  @param b The set to merge into this.
+		 *  @return This set.
+		 */
+		DynamicBitset& operator|=(const DynamicBitset& b) {
+			if (b.words.size() > words.size())
+				words.resize(b.words.size(), 0);
+			for (size_t i = 0; i < b.words.size(); ++i)
+				words[i] |= b.words[i];
+			return *this;
+		}
+
+	  private:
+		typedef unsigned long long Word;
+		static const size_t WordBits = std::numeric_limits<Word>::digits;
+		std::vector<Word> words;
+	};
+
+	/**
+	 *  @brief  The SlotMap class stores objects in a dense array of slots and identifies them by IDs encoding both the
+	 * index of the slot and its generation, which is increased each time the slot is released. Insertion, removal and
+	 * lookup cost O(1), and an ID of a removed object is detected as stale even after its slot has been reused.
+	 *  @note   The objects of released slots are reset to T(), so iterating the map gives all the slots, empty ones
+	 * included.
+	 */
+	template <typename T>
+	class SlotMap {
+	  public:
+		/**
+		 *  @brief  The number of low bits of an ID storing the index of the slot.
+		 */
+		static const size_t IndexBits = std::numeric_limits<size_t>::digits / 2;
+
+		/**
+		 *  @brief  The mask of the bits of an ID storing the index of the slot.
+		 */
+		static const size_t IndexMask = (size_t(1) << IndexBits) - 1;
+
+		/**
+		 *  @brief  The highest generation, after which a slot starts again from 0. The highest bit of IDs is never set,
+		 * so they never collide with the special IDs (e.g. AllWindowIDs).
+		 */
+		static const size_t MaxGeneration = (size_t(1) << (IndexBits - 1)) - 1;
+
+		using Iterator = typename std::vector<T>::iterator;
+		using ConstIterator = typename std::vector<T>::const_iterator;
+
+		/**
+		 *  @brief  The indexOf static method returns the index of the slot identified by an ID.
+		 *  @param id The ID.
+		 *  @return The index of the slot.
+		 */
+		static size_t indexOf(const size_t id) { return id & IndexMask; }
+
+		/**
+		 *  @brief  The generationOf static method returns the generation of the slot identified by an ID.
+		 *  @param id The ID.
+		 *  @return The generation of the slot.
+		 */
+		static size_t generationOf(const size_t id) { return id >> IndexBits; }
+
+		/**
+		 *  @brief  The acquire method books a slot, reusing the least recently released one if any.
+		 *  @return The ID of the slot, which holds T() until set.
+		 */
+		size_t acquire() {
+			size_t index;
+			if (!freeIndices.empty()) {
+				index = freeIndices.front();
+				freeIndices.pop_front();
+			} else {
+				index = values.size();
+				values.push_back(T());
+				slots.push_back(Slot());
+			}
+			slots[index].occupied = true;
+			return (slots[index].generation << IndexBits) | index;
+		}
+
+		/**
+		 *  @brief  The release method frees the slot identified by an ID, resetting its object.
+		 *  @param id The ID of the slot.
+		 *  @return true if released, false if the ID is stale.
+		 */
+		bool release(const size_t id) {
+			if (!contains(id))
+				return false;
+			const size_t index = indexOf(id);
+			Slot& s = slots[index];
+			s.occupied = false;
+			s.generation = s.generation == MaxGeneration ? 0 : s.generation + 1;
+			freeIndices.push_back(index);
+			values[index] = T();
+			return true;
+		}
+
+		/**
+		 *  @brief  The contains method says if an ID identifies a booked slot.
+		 *  @param id The ID.
+		 *  @return true if the slot is booked, false if the ID is stale or invalid.
+		 */
+		bool contains(const size_t id) const {
+			const size_t index = indexOf(id);
+			return index < slots.size() && slots[index].occupied && slots[index].generation == generationOf(id);
+		}
+
+		/**
+		 *  @brief  The find method returns the object of the slot identified by an ID.
+		 *  @param id The ID.
+		 *  @return A pointer to the object, or nullptr if the ID is stale or invalid.
+		 */
+		T* find(const size_t id) { return contains(id) ? &values[indexOf(id)] : nullptr; }
+
+		/**
+		 *  @brief  The get method returns the object of the slot identified by an ID.
+		 *  @param id The ID.
+		 *  @return A reference to the object, or to T() if the ID is stale or invalid.
+		 */
+		const T& get(const size_t id) const { return contains(id) ? values[indexOf(id)] : none; }
+
+		/**
+		 *  @brief  The getAt method returns the object of a slot given its index.
+		 *  @param index The index of the slot.
+		 *  @return A reference to the object, or to T() if the slot is not booked.
+		 */
+		const T& getAt(const size_t index) const {
+			return index < slots.size() && slots[index].occupied ? values[index] : none;
+		}
+
+		/**
+		 *  @brief  The clear method releases all the slots and forgets their generations.
+		 */
+		void clear() {
+			values.clear();
+			slots.clear();
+			freeIndices.clear();
+		}
+
+		/**
+		 *  @brief  The swap method exchanges the content of two maps.
+		 *  @param m The map to swap with.
+		 */
+		void swap(SlotMap& m) {
+			values.swap(m.values);
+			slots.swap(m.slots);
+			freeIndices.swap(m.freeIndices);
+		}
+
+		Iterator begin() { return values.begin(); }
+		Iterator end() { return values.end(); }
+		ConstIterator begin() const { return values.begin(); }
+		ConstIterator end() const { return values.end(); }
+
+	  private:
+		/**
+		 *  @brief  The Slot struct stores the bookkeeping of a slot, apart from the objects to keep them dense.
+		 */
+		struct Slot {
+			size_t generation;
+			bool occupied;
+			Slot() : generation(0), occupied(false) {}
+		};
+
+		std::vector<T> values;
+		std::vector<Slot> slots;
+		std::deque<size_t> freeIndices;
+		const T none = T();
+	};
+
+#ifndef NO_MULTITHREADING
+	/**
+	 *  @brief  The SeqLock class stores a trivially copyable value written by a single thread and read by any thread
+	 * without locking: readers retry if a write happened meanwhile, so they never block the writer nor each other.
+	 */
+	template <typename T>
+	class SeqLock {
+	  public:
+		/**
+		 *  @brief  Constructor.
+		 *  @param value The initial value.
+		 */
+		explicit SeqLock(const T& value = T()) : sequence(0) { store(value); }
+
+		SeqLock(const SeqLock&) = delete;
+		SeqLock& operator=(const SeqLock&) = delete;
+
+		/**
+		 *  @brief  The load method returns a consistent copy of the value.
+		 *  @return The value.
+		 */
+		T load() const {
+			Word w[WordCount];
+			unsigned long long before, after;
+			do {
+				before = sequence.load(std::memory_order_acquire);
+				for (size_t i = 0; i < WordCount; ++i)
+					w[i] = words[i].load(std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				after = sequence.load(std::memory_order_relaxed);
+			} while (before != after || (before & 1));
+			T value;
+			std::memcpy(&value, w, sizeof(T));
+			return value;
+		}
+
+		/**
+		 *  @brief  The store method sets the value.
+		 *  @param value The value.
+		 *  @note   It must not be called by several threads at the same time.
+		 */
+		void store(const T& value) {
+			Word w[WordCount] = {};
+			std::memcpy(w, &value, sizeof(T));
+			const unsigned long long s = sequence.load(std::memory_order_relaxed);
+			// an odd sequence tells the readers that a write is in progress
+			sequence.store(s + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for (size_t i = 0; i < WordCount; ++i)
+				words[i].store(w[i], std::memory_order_relaxed);
+			sequence.store(s + 2, std::memory_order_release);
+		}
+
+	  private:
+		typedef unsigned long long Word;
+		static const size_t WordCount = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+		std::atomic<unsigned long long> sequence;
+		std::atomic<Word> words[WordCount];
+	};
+
+	/**
+	 *  @brief  The MPSCQueue class is an unbounded first-in first-out queue where any number of threads push and a
+	 * single thread pops, without locking: pushing costs an allocation and an atomic exchange.
+	 */
+	template <typename T>
+	class MPSCQueue {
+	  public:
+		/**
+		 *  @brief  Constructor.
+		 */
+		MPSCQueue() : head(new Node()), tail(head.load()) {}
+
+		/**
+		 *  @brief  Destructor, discards the objects left.
+		 */
+		~MPSCQueue() {
+			while (tail) {
+				Node* next = tail->next.load(std::memory_order_relaxed);
+				delete tail;
+				tail = next;
+			}
+		}
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+		/**
+		 *  @brief  The push method appends an object. It may be called by any thread.
+		 *  @param value The object to append.
+		 */
+		void push(T value) {
+			Node* n = new Node();
+			n->value = std::move(value);
+			Node* previous = head.exchange(n, std::memory_order_acq_rel);
+			previous->next.store(n, std::memory_order_release);
+		}
+
+		/**
+		 *  @brief  The pop method removes the first object. It must be called by one thread at a time.
+		 *  @param value The object removed.
+		 *  @return true if an object has been removed, false if the queue is empty or the first push is not completed
+		 * yet.
+		 */
+		bool pop(T& value) {
+			Node* next = tail->next.load(std::memory_order_acquire);
+			if (!next)
+				return false;
+			value = std::move(next->value);
+			next->value = T();
+			// the node of the object removed becomes the sentinel
+			delete tail;
+			tail = next;
+			return true;
+		}
+
+		/**
+		 *  @brief  The empty method says if there is no object to pop. It must be called by the popping thread.
+		 *  @return true if the queue is empty, false otherwise.
+		 */
+		bool empty() const { return !tail->next.load(std::memory_order_acquire); }
+
+	  private:
+		struct Node {
+			std::atomic<Node*> next;
+			T value;
+			Node() : next(nullptr) {}
+		};
+
+		std::atomic<Node*> head; ///< The last node pushed, written by the producers.
+		Node* tail;              ///< The sentinel before the first object, owned by the consumer.
+	};
+
+	/**
+	 *  @brief  The Barrier class blocks a fixed number of threads until all of them have arrived. It can be reused
+	 * for any number of phases.
+	 */
+	class Barrier {
+	  public:
+		/**
+		 *  @brief  Constructor.
+		 *  @param count The number of threads to synchronize.
+		 */
+		explicit Barrier(const size_t count) : threshold(count), remaining(count), phase(0) {}
+
+		/**
+		 *  @brief  The arriveAndWait method blocks the calling thread until all the threads have arrived.
+		 */
+		void arriveAndWait() {
+			std::unique_lock<std::mutex> lock(mutex);
+			const size_t arrivalPhase = phase;
+			if (--remaining == 0) {
+				// last to arrive: start a new phase and wake up the others
+				++phase;
+				remaining = threshold;
+				lock.unlock();
+				conditionVariable.notify_all();
+				return;
+			}
+			conditionVariable.wait(lock, [this, arrivalPhase]() -> bool { return phase != arrivalPhase; });
+		}
+
+	  private:
+		const size_t threshold;
+		size_t remaining;
+		size_t phase;
+		std::mutex mutex;
+		std::condition_variable conditionVariable;
+	};
+#endif
+
 }
 
 #endif
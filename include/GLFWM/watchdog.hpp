@@ -0,0 +1,216 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_WATCHDOG_HPP
+#define GLFWM_WATCHDOG_HPP
+
+#include <GLFWM/drawable.hpp>
+#include <GLFWM/event_handler.hpp>
+#ifndef NO_MULTITHREADING
+#include <atomic>
+#include <functional>
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The Watchdog class runs a thread which monitors the heartbeats of the main loop and of the WindowGroup
+	 * loops, and reports every Drawable or EventHandler blocking its loop for longer than a threshold.
+	 */
+	class Watchdog {
+		struct Heartbeat;
+
+	  public:
+		/**
+		 *  @brief  The Stall struct describes a loop blocked by a Drawable or an EventHandler.
+		 */
+		struct Stall {
+			std::chrono::steady_clock::time_point time; ///< When the stall has been detected.
+			WindowGroupID groupID;                      ///< The group whose loop is blocked, or NoWindowGroupID for
+			                                            ///< the main loop.
+			WindowID windowID;                          ///< The Window being drawn or handling an event.
+			DrawablePointer drawable;                   ///< The Drawable blocking, if drawing.
+			EventHandlerPointer handler;                ///< The EventHandler blocking, if handling an event.
+			double duration;                            ///< The time the loop has been blocked when detected, in seconds.
+		};
+
+		/**
+		 *  @brief  The Callback type is the function called from the watchdog thread for each stall detected.
+		 */
+		using Callback = std::function<void(const Stall&)>;
+
+		/**
+		 *  @brief  The Activity class marks, for its lifetime, the calling thread as busy in a Drawable or an
+		 * EventHandler of a Window. It does nothing if the Watchdog is not running.
+		 *  @note   The Drawable or EventHandler is referred to, not copied, so it must stay bound to the Window for the
+		 * lifetime of the Activity.
+		 */
+		class Activity {
+		  public:
+			/**
+			 *  @brief  Constructor for drawing.
+			 *  @param windowID The ID of the Window being drawn.
+			 *  @param drawable The Drawable drawing.
+			 */
+			Activity(const WindowID windowID, const DrawablePointer& drawable);
+
+			/**
+			 *  @brief  Constructor for handling events.
+			 *  @param windowID The ID of the Window handling an event.
+			 *  @param handler  The EventHandler handling the event.
+			 */
+			Activity(const WindowID windowID, const EventHandlerPointer& handler);
+
+			/**
+			 *  @brief  Destructor, marks the calling thread as not busy.
+			 */
+			~Activity();
+
+			Activity(const Activity&) = delete;
+			Activity& operator=(const Activity&) = delete;
+
+		  private:
+			/**
+			 *  @brief  The heartbeat beaten by the activity, or null if not monitored.
+			 */
+			std::shared_ptr<Heartbeat> heartbeat;
+		};
+
+		/**
+		 *  @brief  The start static method starts the watchdog thread.
+		 *  @param threshold The time a loop may be blocked before being reported, in seconds.
+		 *  @param callback  The function called for each stall, from the watchdog thread. It may be empty.
+		 *  @note   The heartbeats are checked four times per threshold.
+		 */
+		static void start(const double threshold = 1.0, const Callback& callback = Callback());
+
+		/**
+		 *  @brief  The stop static method stops the watchdog thread and synchronizes with its ending.
+		 *  @note   It must not be called from the callback.
+		 */
+		static void stop();
+
+		/**
+		 *  @brief  The isRunning static method says if the watchdog thread is running.
+		 *  @return true if running, false otherwise.
+		 */
+		static bool isRunning();
+
+		/**
+		 *  @brief  The getStalls static method returns the most recent stalls, oldest first.
+		 *  @param stalls The list of stalls.
+		 */
+		static void getStalls(std::deque<Stall>& stalls);
+
+		/**
+		 *  @brief  The setCurrentLoop static method sets the loop whose heartbeat the calling thread beats.
+		 *  @param id The ID of the group, or NoWindowGroupID for the main loop.
+		 *  @return The ID of the loop previously set, or AnyWindowGroupID if none.
+		 */
+		static WindowGroupID setCurrentLoop(const WindowGroupID id);
+
+	  private:
+		/**
+		 *  @brief  The Heartbeat struct stores the state of a loop, written by the thread running the loop and read by
+		 * the watchdog thread.
+		 */
+		struct Heartbeat {
+			std::mutex mutex;                ///< Guards the fields below.
+			unsigned long long beats;        ///< Increased at the beginning and at the end of each activity.
+			bool busy;                       ///< Whether an activity is in progress.
+			WindowID windowID;               ///< The Window of the activity in progress.
+			const DrawablePointer* drawable; ///< The Drawable of the activity in progress, if drawing.
+			const EventHandlerPointer* handler; ///< The EventHandler of the activity in progress, if handling.
+			unsigned long long lastBeats;    ///< The beats seen by the last check of the watchdog thread.
+			std::chrono::steady_clock::time_point lastChange; ///< When the watchdog thread saw the beats change.
+			bool reported;                   ///< Whether the activity in progress has been reported.
+			Heartbeat()
+			    : beats(0), busy(false), windowID(0), drawable(nullptr), handler(nullptr), lastBeats(0), reported(false) {}
+		};
+
+		/**
+		 *  @brief  The beginActivity static method marks the calling thread as busy.
+		 *  @param windowID The ID of the Window.
+		 *  @param drawable The Drawable, or null.
+		 *  @param handler  The EventHandler, or null.
+		 *  @return The heartbeat of the loop of the calling thread, or null if the activity is not monitored.
+		 */
+		static std::shared_ptr<Heartbeat> beginActivity(const WindowID windowID,
+		                          const DrawablePointer* drawable,
+		                          const EventHandlerPointer* handler);
+
+		/**
+		 *  @brief  The endActivity static method marks the loop of an activity as not busy.
+		 *  @param heartbeat The heartbeat returned by beginActivity.
+		 */
+		static void endActivity(Heartbeat& heartbeat);
+
+		/**
+		 *  @brief  The watchdogLoop static method is the function executed by the watchdog thread.
+		 */
+		static void watchdogLoop();
+
+		/**
+		 *  @brief  The loop whose heartbeat the current thread beats, or AnyWindowGroupID if none.
+		 */
+		static thread_local WindowGroupID currentLoop;
+
+		/**
+		 *  @brief  The heartbeat of currentLoop, looked up at the first activity.
+		 */
+		static thread_local std::shared_ptr<Heartbeat> currentHeartbeat;
+
+		/**
+		 *  @brief  Flag telling whether the watchdog thread is running, read by the loops to beat their heartbeats.
+		 */
+		static std::atomic<bool> running;
+
+		/**
+		 *  @brief  The time a loop may be blocked before being reported, in seconds.
+		 */
+		static double threshold;
+
+		/**
+		 *  @brief  The function called for each stall.
+		 */
+		static Callback callback;
+
+		/**
+		 *  @brief  The heartbeats of the loops, by group ID (NoWindowGroupID for the main loop).
+		 */
+		static std::unordered_map<WindowGroupID, std::shared_ptr<Heartbeat>> heartbeats;
+
+		/**
+		 *  @brief  The most recent stalls.
+		 */
+		static std::deque<Stall> stalls;
+
+		/**
+		 *  @brief  The watchdog thread.
+		 */
+		static std::thread thread;
+
+		/**
+		 *  @brief  Condition variable used to wake up the watchdog thread when stopping.
+		 */
+		static std::condition_variable conditionVariable;
+
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+		 */
+		static std::mutex globalMutex;
+	};
+
+}
+#endif
+
+#endif
@@ -14,8 +14,12 @@
 #ifndef GLFWM_WINDOW_HPP
 #define GLFWM_WINDOW_HPP
 
+#include <GLFWM/concurrency.hpp>
+#include <GLFWM/contention_detector.hpp>
 #include <GLFWM/drawable.hpp>
 #include <GLFWM/event_handler.hpp>
+#include <GLFWM/watchdog.hpp>
+#include <GLFWM/window_pool.hpp>
 
 namespace glfwm {
 
@@ -26,6 +30,37 @@ namespace glfwm {
 	 */
 	using WindowPointer = std::shared_ptr<Window>;
 
+	/**
+	 *  @brief  The WindowRef class is a non-owning reference to a Window. Unlike a WindowPointer, copying it does not
+	 * touch the shared reference count, so it suits the hot paths. See Window::borrowWindow for how long it is valid.
+	 */
+	class WindowRef {
+	  public:
+		/**
+		 *  @brief  Constructor of a null reference.
+		 */
+		WindowRef() : window(nullptr) {}
+
+		/**
+		 *  @brief  Constructor.
+		 *  @param w The Window to refer to, or nullptr.
+		 */
+		explicit WindowRef(Window* w) : window(w) {}
+
+		/**
+		 *  @brief  The get method returns the Window referred to.
+		 *  @return A pointer to the Window, or nullptr.
+		 */
+		Window* get() const { return window; }
+
+		Window* operator->() const { return window; }
+		Window& operator*() const { return *window; }
+		explicit operator bool() const { return window != nullptr; }
+
+	  private:
+		Window* window;
+	};
+
 	/**
 	 *  @brief  The Window class represents a GLFWWindow with a set of threading facilities and some handlers for
 	 * interactive objects, like event handlers or drawables.
@@ -37,6 +72,35 @@ namespace glfwm {
 		 */
 		using RankType = int;
 
+		/**
+		 *  @brief  The State struct stores the properties of a Window last reported by GLFW.
+		 */
+		struct State {
+			int x;                 ///< The x coordinate of the window area, in screen coordinates.
+			int y;                 ///< The y coordinate of the window area, in screen coordinates.
+			int width;             ///< The width of the window area, in screen coordinates.
+			int height;            ///< The height of the window area, in screen coordinates.
+			int framebufferWidth;  ///< The width of the framebuffer, in pixels.
+			int framebufferHeight; ///< The height of the framebuffer, in pixels.
+			float xScale;          ///< The content scale in x.
+			float yScale;          ///< The content scale in y.
+			bool focused;          ///< Whether the window has input focus.
+			bool iconified;        ///< Whether the window is iconified.
+			bool maximized;        ///< Whether the window is maximized.
+			State()
+			    : x(0),
+			      y(0),
+			      width(0),
+			      height(0),
+			      framebufferWidth(0),
+			      framebufferHeight(0),
+			      xScale(0.0f),
+			      yScale(0.0f),
+			      focused(false),
+			      iconified(false),
+			      maximized(false) {}
+		};
+
 		/**
 		 *  @brief  Contructor. See newWindow for a reliable construction.
 		 *  @param  id The ID of this new window. See newWindowID.
@@ -45,6 +109,8 @@ namespace glfwm {
 		 *  @param  title The title of the window.
 		 *  @param  monitor The GLFWMonitor to associate this window to in case of fullscreen. Use nullptr otherwise.
 		 *  @param  share Another Window to share the context with. Use nullptr for a non-shared context.
+		 *  @param  poolHints The hints set for creating the window, on top of the default ones, for recycling GLFW
+		 * windows (see WindowPool). Use nullptr if not known, and the window is neither recycled nor kept.
 		 *  @note   The creation of a GLFW window may occur only in the main thread. Do not instantiate a Window in
 		 * secondary threads.
 		 */
@@ -53,7 +119,8 @@ namespace glfwm {
 		       const int height,
 		       const std::string& title,
 		       GLFWmonitor* monitor = nullptr,
-		       const WindowPointer& share = WindowPointer(nullptr));
+		       const WindowPointer& share = WindowPointer(nullptr),
+		       const WindowPool::Hints* poolHints = nullptr);
 
 		/**
 		 *  @brief  The copy constructor is deleted, i.e. a Window can not be copied.
@@ -98,6 +165,12 @@ namespace glfwm {
 		 */
 		WindowID getID() const;
 
+		/**
+		 *  @brief  The getGroupID method returns the ID of the WindowGroup this Window is attached to, without locking.
+		 *  @return The ID of the group, or NoWindowGroupID.
+		 */
+		WindowGroupID getGroupID() const;
+
 		/**
 		 *  @brief  The bindEventHandler method binds an EventHandler by adding it to the list of handlers in a position
 		 * determined by the rank r.
@@ -144,6 +217,16 @@ namespace glfwm {
 		 */
 		void draw();
 
+		/**
+		 *  @brief  The prepareWindows static method calls Drawable::prepare on the drawables of some Windows which
+		 * implement it, in rank order within each Window and in parallel, on the Executor, across the Windows.
+		 *  @param ids   The IDs of the Windows going to be drawn.
+		 *  @param frame The frame going to be drawn.
+		 *  @note   It returns when all the drawables have been prepared. If NO_MULTITHREADING is defined, the Windows
+		 * are prepared one after the other on the calling thread.
+		 */
+		static void prepareWindows(const std::vector<WindowID>& ids, const FrameInfo& frame);
+
 		/**
 		 *  @brief  The shouldClose method is a wrapper of glfwWindowShouldClose.
 		 *  @return true if this window should close, false otherwise.
@@ -157,7 +240,7 @@ namespace glfwm {
 		void setShouldClose(const bool c);
 
 		/**
-		 *  @brief  The getTitle method returns the current title.
+		 *  @brief  The getTitle method returns the current title, or the one set and not applied yet.
 		 *  @note   This may only be called from the main thread.
 		 *  @return This window's current title.
 		 */
@@ -166,7 +249,8 @@ namespace glfwm {
 		/**
 		 *  @brief  The setTitle method changes the current title.
 		 *  @param title The new window title.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   This may be called from any thread: the title is applied by the main loop, see
+		 * applyPendingProperties.
 		 */
 		void setTitle(const std::string& title);
 
@@ -174,7 +258,7 @@ namespace glfwm {
 		 *  @brief  The getPosition method returns the x and y screen coordinate position.
 		 *  @param x The x coordinate.
 		 *  @param y The y coordintate.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   This may be called from any thread without locking, see getState.
 		 */
 		void getPosition(int& x, int& y) const;
 
@@ -182,7 +266,8 @@ namespace glfwm {
 		 *  @brief  The setPosition method sets the x and y screen coordinate position.
 		 *  @param x The x coordinate.
 		 *  @param y The y coordintate.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   This may be called from any thread: the position is applied by the main loop, see
+		 * applyPendingProperties.
 		 */
 		void setPosition(const int x, const int y);
 
@@ -190,7 +275,7 @@ namespace glfwm {
 		 *  @brief  The getSize method returns the width and height of this window area.
 		 *  @param width The width of this window area.
 		 *  @param height The height of this window area.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   This may be called from any thread without locking, see getState.
 		 */
 		void getSize(int& width, int& height) const;
 
@@ -198,7 +283,8 @@ namespace glfwm {
 		 *  @brief  The setSize method sets the width and height of this window area.
 		 *  @param width The width of this window area.
 		 *  @param height The height of this window area.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   This may be called from any thread: the size is applied by the main loop, see
+		 * applyPendingProperties.
 		 */
 		void setSize(const int width, const int height);
 
@@ -241,7 +327,7 @@ namespace glfwm {
 		 *  @brief  The getFramebufferSize method returns the width and height of this window framebuffer.
 		 *  @param width The width of this window framebuffer.
 		 *  @param height The height of this window framebuffer.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   This may be called from any thread without locking, see getState.
 		 */
 		void getFramebufferSize(int& width, int& height) const;
 
@@ -267,7 +353,7 @@ namespace glfwm {
 		 *  which monitor the system considers the window to be on.
 		 *  @param xScale The scale in x of this window content.
 		 *  @param yScale The scale in y of this window content.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   This may be called from any thread without locking, see getState.
 		 */
 		void getContentScale(float& xScale, float& yScale) const;
 
@@ -292,7 +378,8 @@ namespace glfwm {
 		 * this are undefined.
 		 *
 		 * @param opacity The opacity to set to this window.
-		 * @note   This may only be called from the main thread.
+		 * @note   This may be called from any thread: the opacity is applied by the main loop, see
+		 * applyPendingProperties.
 		 */
 		void setOpacity(float opacity);
 
@@ -461,10 +548,20 @@ namespace glfwm {
 		 *  @brief  The getAttribute method returns this window attributes. See GLFW.
 		 *  @param  attribute The attribute to read.
 		 *  @return The value of attribute for this window.
-		 *  @note   This may only be called from the main thread.
+		 *  @note   GLFW_FOCUSED, GLFW_ICONIFIED and GLFW_MAXIMIZED may be read from any thread without locking, see
+		 * getState. The other attributes may only be read from the main thread.
 		 */
 		int getAttribute(const int attribute) const;
 
+		/**
+		 *  @brief  The getState method returns the position, sizes, content scale, focus, iconification and
+		 * maximization of this window all together.
+		 *  @return The properties last reported by GLFW.
+		 *  @note   This may be called from any thread without locking: the properties are cached and refreshed by the
+		 * callbacks, which WindowManager registers for each Window it creates.
+		 */
+		State getState() const;
+
 		/**
 		 *  @brief  The setAttribute method sets this window `attribute` to the specified `value`. See GLFW.
 		 *  @param  attribute The attribute to write.
@@ -500,21 +597,89 @@ namespace glfwm {
 		void setClipboardString(const std::string& text);
 
 		/**
-		 *  @brief  The swapBuffers method swaps the front and the back buffer.
+		 *  @brief  The swapBuffers method swaps the front and the back buffer. It does nothing if this Window has no
+		 * context, see hasContext.
 		 */
 		void swapBuffers();
 
 		/**
-		 *  @brief  The makeContextCurrent method makes the context associated to this window current.
+		 *  @brief  The makeContextCurrent method makes the context associated to this window current, unless it is
+		 * already current on the calling thread. If this Window has no context (see hasContext), it only locks the
+		 * Window.
+		 *  @note   The context current on each thread is tracked by this method, releaseCurrentContext and
+		 * doneCurrentContext: switch contexts directly with GLFW only after releaseCurrentContext.
 		 */
 		void makeContextCurrent();
 
 		/**
 		 *  @brief  The doneCurrentContext method releases the resources held by makeContextCurrent.
+		 *  @param keepCurrent true for keeping the context current on the calling thread, so that the next
+		 * makeContextCurrent on this window is free, false for releasing it, e.g. before another thread uses it.
 		 *  @note   A call to this may only follow a call to makeContextCurrent, without nesting, otherwise the
-		 * behaviour is undefined. This method does nothing if NO_MULTITHREADING is defined.
+		 * behaviour is undefined. If NO_MULTITHREADING is defined, this method only releases the context, if requested.
+		 */
+		void doneCurrentContext(const bool keepCurrent = true);
+
+		/**
+		 *  @brief  The releaseCurrentContext static method makes no context current on the calling thread, if one has
+		 * been made current by makeContextCurrent.
+		 */
+		static void releaseCurrentContext();
+
+		/**
+		 *  @brief  The getContextSwitchCounts static method returns how many times makeContextCurrent has switched
+		 * context, and how many times it has not as the context was already current, in all threads.
+		 *  @param switches The number of switches made.
+		 *  @param avoided  The number of switches avoided.
+		 */
+		static void getContextSwitchCounts(unsigned long long& switches, unsigned long long& avoided);
+
+		/**
+		 *  @brief  The resetContextSwitchCounts static method sets the counts of getContextSwitchCounts to zero.
+		 */
+		static void resetContextSwitchCounts();
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  The getContextShareID method returns an ID shared by all the Windows whose contexts share objects
+		 * with this Window's one.
+		 *  @return The ID of the share group of this Window's context.
+		 */
+		size_t getContextShareID() const;
+#endif
+
+		/**
+		 *  @brief  The hasContext method says if this Window has an OpenGL or OpenGL ES context, i.e. if it has not
+		 * been created with the GLFW_CLIENT_API hint set to GLFW_NO_API, as for Vulkan.
+		 *  @return true if this Window has a context, false otherwise.
+		 */
+		bool hasContext() const;
+
+		/**
+		 *  @brief  The addTag method labels this Window with a tag, so that it can be addressed together with the
+		 * other Windows with the same tag (e.g. see UpdateMap::notifyTag).
+		 *  @param tag The tag.
+		 */
+		void addTag(const std::string& tag);
+
+		/**
+		 *  @brief  The removeTag method removes a tag from this Window.
+		 *  @param tag The tag.
+		 */
+		void removeTag(const std::string& tag);
+
+		/**
+		 *  @brief  The hasTag method says if this Window is labelled with a tag.
+		 *  @param tag The tag.
+		 *  @return true if this Window has the tag, false otherwise.
+		 */
+		bool hasTag(const std::string& tag) const;
+
+		/**
+		 *  @brief  The getTags method returns the tags of this Window.
+		 *  @param tags The set of tags.
 		 */
-		void doneCurrentContext();
+		void getTags(std::unordered_set<std::string>& tags) const;
 
 #ifdef VK_VERSION_1_0
 		/**
@@ -538,6 +703,32 @@ namespace glfwm {
 		VkResult createVulkanWindowSurface(VkInstance instance,
 		                                   const VkAllocationCallbacks* allocator,
 		                                   VkSurfaceKHR* surface);
+
+		/**
+		 *  @brief  The createVulkanSurface method creates a Vulkan surface for this window, owned by this Window,
+		 * destroying the one previously created, if any.
+		 *  @param instance  The Vulkan instance to create the surface in.
+		 *  @param allocator The allocator to use, or nullptr to use the default allocator. It is also used for
+		 * destroying the surface.
+		 *  @return VK_SUCCESS if successful, or a Vulkan error code if an error occurred (see
+		 * createVulkanWindowSurface).
+		 *  @note   The surface is destroyed by destroyVulkanSurface or, at the latest, when this Window is destroyed,
+		 * before its GLFW window. Thus the Vulkan instance must outlive this Window or the call to
+		 * destroyVulkanSurface.
+		 */
+		VkResult createVulkanSurface(VkInstance instance, const VkAllocationCallbacks* allocator = nullptr);
+
+		/**
+		 *  @brief  The getVulkanSurface method returns the Vulkan surface created by createVulkanSurface.
+		 *  @return The surface, or VK_NULL_HANDLE if none.
+		 */
+		VkSurfaceKHR getVulkanSurface() const;
+
+		/**
+		 *  @brief  The destroyVulkanSurface method destroys the Vulkan surface created by createVulkanSurface, if any.
+		 *  @note   The swapchains created for the surface must have been destroyed already.
+		 */
+		void destroyVulkanSurface();
 #endif
 
 #ifdef GLFW_EXPOSE_NATIVE_WIN32
@@ -659,6 +850,8 @@ namespace glfwm {
 	  private:
 		// The WindowManager is friend for letting it access this Window's private data member glfwWindow.
 		friend class WindowManager;
+		// The WindowGroup is friend for letting it keep owningGroupID up to date.
+		friend class WindowGroup;
 
 		/**
 		 *  @brief  The GLFW window data structure for this Window and its context.
@@ -671,6 +864,128 @@ namespace glfwm {
 		 */
 		const WindowID windowID;
 
+		/**
+		 *  @brief  The user pointer set with setUserPointer. The GLFW window's user pointer is reserved to this Window.
+		 */
+		void* userPointer;
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  The ID of the WindowGroup this Window is attached to.
+		 */
+		std::atomic<WindowGroupID> owningGroupID;
+
+		/**
+		 *  @brief  The properties last reported by GLFW, written by the main thread only.
+		 */
+		SeqLock<State> state;
+#else
+		/**
+		 *  @brief  The ID of the WindowGroup this Window is attached to.
+		 */
+		WindowGroupID owningGroupID;
+
+		/**
+		 *  @brief  The properties last reported by GLFW.
+		 */
+		State state;
+#endif
+
+		/**
+		 *  @brief  The types of the events whose callbacks have been registered by the WindowManager for being handled.
+		 */
+		EventBaseType callbackEventTypes;
+
+		/**
+		 *  @brief  Whether the GLFW window is put into the WindowPool when destroyed, with the hints poolKey.
+		 */
+		bool recyclable;
+
+		/**
+		 *  @brief  The hints of the GLFW window, see WindowPool::makeKey.
+		 */
+		WindowPool::Hints poolKey;
+
+		/**
+		 *  @brief  Whether the GLFW window has a context, see hasContext. It does not change after the creation.
+		 */
+		bool withContext;
+
+#ifdef VK_VERSION_1_0
+		VkInstance vulkanInstance;                    ///< The instance of vulkanSurface.
+		const VkAllocationCallbacks* vulkanAllocator; ///< The allocator of vulkanSurface.
+		VkSurfaceKHR vulkanSurface;                   ///< The surface created by createVulkanSurface.
+#endif
+
+		/**
+		 *  @brief  The storeState method sets the cached properties of this window.
+		 *  @param s The properties.
+		 *  @note   This may only be called from the main thread.
+		 */
+		void storeState(const State& s);
+
+		/**
+		 *  @brief  The refreshState method reads all the cached properties of this window from GLFW.
+		 *  @note   This may only be called from the main thread.
+		 */
+		void refreshState();
+
+		/**
+		 *  @brief  The PropertyFlag enum lists the properties which may be pending.
+		 */
+		enum PropertyFlag : unsigned int {
+			TitleProperty = 1 << 0,
+			PositionProperty = 1 << 1,
+			SizeProperty = 1 << 2,
+			OpacityProperty = 1 << 3
+		};
+
+		/**
+		 *  @brief  The PendingProperties struct stores the last values written to the properties of a Window, waiting
+		 * to be applied by the main loop.
+		 */
+		struct PendingProperties {
+			unsigned int flags; ///< The properties written, as a mask of PropertyFlag.
+			std::string title;  ///< The title, if TitleProperty.
+			int x;              ///< The x coordinate, if PositionProperty.
+			int y;              ///< The y coordinate, if PositionProperty.
+			int width;          ///< The width, if SizeProperty.
+			int height;         ///< The height, if SizeProperty.
+			float opacity;      ///< The opacity, if OpacityProperty.
+			PendingProperties() : flags(0), x(0), y(0), width(0), height(0), opacity(1.0f) {}
+		};
+
+		/**
+		 *  @brief  The properties written and not applied yet. Guarded by propertiesMutex.
+		 */
+		PendingProperties pendingProperties;
+
+		/**
+		 *  @brief  The title and opacity last applied, for dropping redundant writes. Used by the main thread only.
+		 */
+		std::string appliedTitle;
+		float appliedOpacity;
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent management of pendingProperties, apart from the context.
+		 */
+		mutable std::mutex propertiesMutex;
+#endif
+
+		/**
+		 *  @brief  The writeProperties method records the properties written, queuing this window for the main loop.
+		 *  @param flag The property written.
+		 *  @param p    The values of the properties, of which only those in flag are read.
+		 */
+		void writeProperties(const PropertyFlag flag, const PendingProperties& p);
+
+		/**
+		 *  @brief  The applyProperties method applies the pending properties of this window.
+		 *  @note   This may only be called from the main thread.
+		 */
+		void applyProperties();
+
 		/**
 		 *  @brief  The EventHandlerRank struct stores a pointer to an EventHandler and its rank which determines its
 		 * position in the list.
@@ -735,11 +1050,44 @@ namespace glfwm {
 		 */
 		DrawableMap drawableMap;
 
+		/**
+		 *  @brief  The number of bound Drawables implementing prepare, so that prepareWindows skips the other Windows
+		 * without locking them.
+		 */
 #ifndef NO_MULTITHREADING
+		std::atomic<size_t> preparingDrawables;
+#else
+		size_t preparingDrawables;
+#endif
+
+		/**
+		 *  @brief  The ID of the Window whose context is current on the calling thread, or AllWindowIDs if none. The
+		 * IDs of deleted windows become stale, so a recycled GLFW window is never mistaken for the current one.
+		 */
+		static thread_local WindowID currentContextID;
+
 		/**
-		 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+		 *  @brief  The drawables to prepare collected by prepareWindows on the calling thread, with their Window, and
+		 * where those of each Window start. They are reused frame after frame.
 		 */
-		static std::recursive_mutex globalMutex;
+		static thread_local std::vector<std::pair<WindowID, DrawablePointer>> drawablesToPrepare;
+		static thread_local std::vector<size_t> prepareJobStarts;
+
+#ifndef NO_MULTITHREADING
+		static std::atomic<unsigned long long> contextSwitches;        ///< The switches made by makeContextCurrent.
+		static std::atomic<unsigned long long> avoidedContextSwitches; ///< The switches avoided by makeContextCurrent.
+#else
+		static unsigned long long contextSwitches;        ///< The switches made by makeContextCurrent.
+		static unsigned long long avoidedContextSwitches; ///< The switches avoided by makeContextCurrent.
+#endif
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent management of static activities. Lookups lock it shared,
+		 * creations and deletions exclusively. It is skipped by the main thread while concurrency is not active, see
+		 * Concurrency.
+		 */
+		static ElidableShardedMutex globalMutex;
 
 		/**
 		 *  @brief  The type of the ID used to identify a mutex.
@@ -755,9 +1103,10 @@ namespace glfwm {
 		 *  @brief  The MutexData struct is just a wrapper for a mutex together with its number of users.
 		 */
 		struct MutexData {
-			std::recursive_mutex mutex;
+			ElidableRecursiveMutex mutex;
 			size_t count;
-			MutexData() : count(0) {}
+			std::atomic<WindowGroupID> ownerGroupID; ///< The group of the thread that last acquired the mutex.
+			MutexData() : count(0), ownerGroupID(NoWindowGroupID) {}
 		};
 
 		/**
@@ -776,6 +1125,13 @@ namespace glfwm {
 		 */
 		static MutexID newMutexID();
 
+		/**
+		 *  @brief  The shareMutexID static method increases the number of users of a mutex already booked.
+		 *  @param id The ID of the mutex.
+		 *  @return The same ID.
+		 */
+		static MutexID shareMutexID(const MutexID id);
+
 		/**
 		 *  @brief  The decreaseMutexCount static method decreases the number of users of a mutex, eventually freeing
 		 * it.
@@ -785,33 +1141,40 @@ namespace glfwm {
 #endif
 
 		/**
-		 *  @brief  The WindowMap class is a hash table used to map GLFWWindow pointers to Window IDs.
+		 *  @brief  The container for collecting Windows, whose slots are identified by WindowIDs.
 		 */
-		using WindowMap = std::unordered_map<GLFWwindow*, WindowID>;
+		static SlotMap<WindowPointer> windows;
 
 		/**
-		 *  @brief  The iterator for accessing the WindowMap.
+		 *  @brief  The Windows deleted but possibly still borrowed, see borrowWindow. Guarded by globalMutex.
 		 */
-		using WindowMapIterator = WindowMap::iterator;
+		static std::vector<WindowPointer> retiredWindows;
 
 		/**
-		 *  @brief  The map between GLFWWindow pointers and WindowIDs.
+		 *  @brief  The Windows with pending properties, see applyPendingProperties. Guarded by propertiesGlobalMutex.
 		 */
-		static WindowMap windowsMap;
+		static std::vector<WindowID> windowsWithPendingProperties;
 
+#ifndef NO_MULTITHREADING
 		/**
-		 *  @brief  The container for collecting Windows.
+		 *  @brief  Mutex used to guarantee correct concurrent management of windowsWithPendingProperties.
 		 */
-		static std::deque<WindowPointer> windows;
+		static std::mutex propertiesGlobalMutex;
+#endif
 
 		/**
-		 *  @brief  The container for reusing freed WindowIDs. It is kept sorted.
+		 *  @brief  The tags of this Window. Guarded by globalMutex.
 		 */
-		static std::deque<WindowID> freedWindowIDs;
+		std::unordered_set<std::string> tags;
+
+		/**
+		 *  @brief  The inverted index between tags and the Windows labelled with them.
+		 */
+		static std::unordered_map<std::string, std::unordered_set<WindowID>> taggedWindows;
 
 	  public:
 		/**
-		 *  @brief  The newWindowID static method books a new or an old & freed ID for windows.
+		 *  @brief  The newWindowID static method books a new or an old & freed slot for windows.
 		 *  @return The booked WindowID.
 		 */
 		static WindowID newWindowID();
@@ -819,18 +1182,20 @@ namespace glfwm {
 		/**
 		 *  @brief  The newWindow static method allocates and creates a new Window, storing also internal pointers and
 		 * information in order to easily retrieve it later.
-		 *  @param width   The width of the new window, in screen space.
-		 *  @param height  The height of the new window, in screen space.
-		 *  @param title   The title of the new window.
-		 *  @param monitor The monitor for a fullscreen window, or a null pointer for a non-fullscreen window.
-		 *  @param share   The Window to share its context with, or a null pointer otherwise.
+		 *  @param width     The width of the new window, in screen space.
+		 *  @param height    The height of the new window, in screen space.
+		 *  @param title     The title of the new window.
+		 *  @param monitor   The monitor for a fullscreen window, or a null pointer for a non-fullscreen window.
+		 *  @param share     The Window to share its context with, or a null pointer otherwise.
+		 *  @param poolHints The hints set for creating the window, or a null pointer if not known. See the constructor.
 		 *  @return A WindowPointer to the new window.
 		 */
 		static WindowPointer newWindow(const int width,
 		                               const int height,
 		                               const std::string& title,
 		                               GLFWmonitor* monitor = nullptr,
-		                               const WindowPointer& share = WindowPointer(nullptr));
+		                               const WindowPointer& share = WindowPointer(nullptr),
+		                               const WindowPool::Hints* poolHints = nullptr);
 
 		/**
 		 *  @brief  The getWindow static method gives the WindowPointer to a Window given its ID.
@@ -839,19 +1204,80 @@ namespace glfwm {
 		 */
 		static WindowPointer getWindow(const WindowID id);
 
+		/**
+		 *  @brief  The borrowWindow static method gives a non-owning reference to a Window given its ID, without
+		 * touching its reference count.
+		 *  @param id The WindowID of the Window to access.
+		 *  @return The reference to the requested Window, or a null reference if it does not exist.
+		 *  @note   Deleted Windows are kept alive until the main loop has started a new iteration and the frames in
+		 * progress in all the groups have ended. Hence the reference is valid until the end of the frame of the group
+		 * it has been borrowed by, or of the iteration of the main loop (e.g. a callback). Use getWindow for keeping a
+		 * Window longer.
+		 */
+		static WindowRef borrowWindow(const WindowID id);
+
+		/**
+		 *  @brief  The reclaimRetiredWindows static method releases the Windows deleted so far, once no frame in
+		 * progress can still be borrowing them.
+		 *  @note   This is called by the main loop at the beginning of each iteration and must not be called while
+		 * drawing.
+		 */
+		static void reclaimRetiredWindows();
+
+		/**
+		 *  @brief  The applyPendingProperties static method applies, in one pass, the titles, positions, sizes and
+		 * opacities set since its last call. Only the last value written to each property is applied, and only if it
+		 * differs from the current one.
+		 *  @note   This is called by the main loop once per iteration. This may only be called from the main thread.
+		 */
+		static void applyPendingProperties();
+
 		/**
 		 *  @brief  The getWindowID static method gives the ID of a Window associated to a GLFWWindow object.
 		 *  @param w The GLFWWindow object pointer.
-		 *  @return The WindowPointer of the associated Window.
+		 *  @return The ID of the associated Window, or AllWindowIDs if none.
+		 *  @note   This does not lock, see fromGLFWWindow.
 		 */
 		static WindowID getWindowID(GLFWwindow* w);
 
+		/**
+		 *  @brief  The fromGLFWWindow static method gives the Window associated to a GLFWWindow object, stored in its
+		 * user pointer, without locking.
+		 *  @param w The GLFWWindow object pointer.
+		 *  @return A non-owning pointer to the associated Window, or nullptr.
+		 *  @note   Windows are destroyed only in the main thread, so the pointer may be safely used there, e.g. in GLFW
+		 * callbacks, until the end of the current iteration of the main loop even if the Window is deleted meanwhile.
+		 * Use borrowWindow in other threads.
+		 */
+		static Window* fromGLFWWindow(GLFWwindow* w);
+
 		/**
 		 *  @brief  The getALlWindowIDs static method returns the set of all the WindowID currently in use.
 		 *  @param wIDs The set of WindowIDs.
 		 */
 		static void getAllWindowIDs(std::unordered_set<WindowID>& wIDs);
 
+		/**
+		 *  @brief  The getTaggedWindowIDs static method returns the set of the WindowIDs labelled with a tag.
+		 *  @param tag  The tag.
+		 *  @param wIDs The set of WindowIDs.
+		 */
+		static void getTaggedWindowIDs(const std::string& tag, std::unordered_set<WindowID>& wIDs);
+
+		/**
+		 *  @brief  The getTaggedWindows static method returns the Windows labelled with a tag, for applying an
+		 * operation to all of them without holding any lock.
+		 *  @param tag The tag.
+		 *  @param ws  The list of Windows.
+		 */
+		static void getTaggedWindows(const std::string& tag, std::vector<WindowPointer>& ws);
+
+		/**
+		 *  @brief  The clearTag static method removes a tag from all the Windows.
+		 *  @param tag The tag.
+		 */
+		static void clearTag(const std::string& tag);
+
 		/**
 		 *  @brief  The isAnyWindowOpen static method says if there is any Window still open.
 		 *  @return true if is there any Window still open, false otherwise.
@@ -877,13 +1303,13 @@ namespace glfwm {
 
 	  private:
 		/**
-		 *  @brief  The unmapWindow static method removes the association between a GLFWWindow object and a Window.
-		 *  @param w The GLFWWindow object to unmap.
+		 *  @brief  The removeAllTags method removes all the tags from this Window.
 		 */
-		static void unmapWindow(GLFWwindow* w);
+		void removeAllTags();
 
 		/**
-		 *  @brief  The freeWindowID frees an ID for a later reuse.
+		 *  @brief  The freeWindowID frees an ID for a later reuse. The ID becomes stale: it will not address any
+		 * Window, even after its slot has been reused.
 		 *  @param id The ID to free.
 		 */
 		static void freeWindowID(const WindowID id);
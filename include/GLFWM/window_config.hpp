@@ -0,0 +1,126 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_WINDOW_CONFIG_HPP
+#define GLFWM_WINDOW_CONFIG_HPP
+
+#include <GLFWM/window.hpp>
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The WindowConfig class bundles everything needed to create a Window, hints included, so that it does not
+	 * depend on the hints set globally (see WindowManager::setHint) and can be built by any thread.
+	 *  @note   It is copied when a creation is requested, so changing it afterwards does not affect the request.
+	 */
+	class WindowConfig {
+	  public:
+		/**
+		 *  @brief  The Hint is a pair of target hint and value, see WindowManager::setHint.
+		 */
+		using Hint = std::pair<int, int>;
+
+		/**
+		 *  @brief  Constructor.
+		 *  @param width  The window width.
+		 *  @param height The window height.
+		 *  @param title  The window title.
+		 *  @note   All the event types are registered for callbacks, no monitor and no share, default hints.
+		 */
+		WindowConfig(const int width = 640, const int height = 480, const std::string& title = std::string());
+
+		/**
+		 *  @brief  The setEventTypes method sets the event types to register callbacks for.
+		 *  @param eventTypes A mask corresponding to the list of event types.
+		 *  @return A reference to this, for chaining.
+		 */
+		WindowConfig& setEventTypes(const EventBaseType eventTypes);
+
+		/**
+		 *  @brief  The setMonitor method sets the monitor for fullscreen.
+		 *  @param monitor A pointer to a monitor for fullscreen, or NULL otherwise.
+		 *  @return A reference to this, for chaining.
+		 */
+		WindowConfig& setMonitor(GLFWmonitor* monitor);
+
+		/**
+		 *  @brief  The setShare method sets the window to share the context with.
+		 *  @param share A pointer to another window to share its context with, or NULL otherwise.
+		 *  @return A reference to this, for chaining.
+		 */
+		WindowConfig& setShare(const WindowPointer& share);
+
+		/**
+		 *  @brief  The setHint method sets a target hint to a given value, replacing the one previously set, if any.
+		 *  @param target The target hint.
+		 *  @param value  The value to set to the hint.
+		 *  @return A reference to this, for chaining.
+		 *  @note   The hints not set take their default values.
+		 */
+		WindowConfig& setHint(const int target, const int value);
+
+		/**
+		 *  @brief  The getWidth method returns the window width.
+		 *  @return The width.
+		 */
+		int getWidth() const;
+
+		/**
+		 *  @brief  The getHeight method returns the window height.
+		 *  @return The height.
+		 */
+		int getHeight() const;
+
+		/**
+		 *  @brief  The getTitle method returns the window title.
+		 *  @return The title.
+		 */
+		const std::string& getTitle() const;
+
+		/**
+		 *  @brief  The getEventTypes method returns the event types to register callbacks for.
+		 *  @return A mask corresponding to the list of event types.
+		 */
+		EventBaseType getEventTypes() const;
+
+		/**
+		 *  @brief  The getMonitor method returns the monitor for fullscreen.
+		 *  @return A pointer to the monitor, or NULL.
+		 */
+		GLFWmonitor* getMonitor() const;
+
+		/**
+		 *  @brief  The getShare method returns the window to share the context with.
+		 *  @return A pointer to the window, or NULL.
+		 */
+		const WindowPointer& getShare() const;
+
+		/**
+		 *  @brief  The getHints method returns the hints set, in the order they were first set.
+		 *  @return The list of hints.
+		 */
+		const std::vector<Hint>& getHints() const;
+
+	  private:
+		int width;                ///< The window width.
+		int height;               ///< The window height.
+		std::string title;        ///< The window title.
+		EventBaseType eventTypes; ///< The event types to register callbacks for.
+		GLFWmonitor* monitor;     ///< The monitor for fullscreen, or NULL.
+		WindowPointer share;      ///< The window to share the context with, or NULL.
+		std::vector<Hint> hints;  ///< The hints set.
+	};
+
+}
+
+#endif
@@ -14,6 +14,8 @@
 #ifndef GLFWM_WINDOW_GROUP_HPP
 #define GLFWM_WINDOW_GROUP_HPP
 
+#include <GLFWM/executor.hpp>
+#include <GLFWM/load_balancer.hpp>
 #include <GLFWM/update_map.hpp>
 #include <GLFWM/window.hpp>
 #ifndef NO_MULTITHREADING
@@ -34,8 +36,26 @@ namespace glfwm {
 	 * moved to another thread.
 	 */
 	class WindowGroup {
+#ifndef NO_MULTITHREADING
+		// The LoadBalancer is friend for letting it read the measured CPU times and request moves of Windows.
+		friend class LoadBalancer;
+		// The Watchdog is friend for letting it record the stalls of this group's loop.
+		friend class Watchdog;
+#endif
 
 	  public:
+		/**
+		 *  @brief  The Statistics struct reports how a group's loop is performing.
+		 */
+		struct Statistics {
+			double framesPerSecond;        ///< Frames drawn per second, measured over the last period (at least 1s).
+			double idlePercentage;         ///< Percentage of the last period not spent drawing.
+			unsigned long long frameCount; ///< Total number of frames drawn so far.
+			double swapSkew;               ///< Seconds between the first and the last swap of the last synchronized
+			                               ///< presentation.
+			unsigned long long stallCount; ///< Number of stalls of this group's loop reported by the Watchdog.
+		};
+
 		/**
 		 *  @brief  Constructor. See newGroup for a reliable construction.
 		 *  @param  id The univoque ID for thiw WindowGroup. See newGroupID.
@@ -97,12 +117,48 @@ namespace glfwm {
 		 */
 		void detachWindow(const WindowID windowID);
 
+		/**
+		 *  @brief  The attachTaggedWindows method adds to this group all the Windows labelled with a tag.
+		 *  @param tag The tag, see Window::addTag.
+		 *  @note   The Windows are detached from their previous groups.
+		 */
+		void attachTaggedWindows(const std::string& tag);
+
 		/**
 		 *  @brief  The empty method returns true if there are not Windows attached to this WindowGroup.
 		 *  @return true if no Window is attached to this group, false otherwise.
 		 */
 		bool empty() const;
 
+		/**
+		 *  @brief  The attachGroup method nests a WindowGroup into this group: notifying this group for update (see
+		 * UpdateMap::notify with WholeGroupWindowIDs) updates also all the groups nested, directly or not, into it.
+		 *  @param childID The ID of the group to nest.
+		 *  @return true if the group has been nested, false if it does not exist or it is this group or one of its
+		 * ancestors.
+		 *  @note   A group can not be nested into more than one group at the same time: it is moved from the previous
+		 * one.
+		 */
+		bool attachGroup(const WindowGroupID childID);
+
+		/**
+		 *  @brief  The detachGroup method removes a nested WindowGroup from this group.
+		 *  @param childID The ID of the nested group.
+		 */
+		void detachGroup(const WindowGroupID childID);
+
+		/**
+		 *  @brief  The getParentGroup method returns the ID of the group this group is nested into.
+		 *  @return The ID of the parent group, or NoWindowGroupID.
+		 */
+		WindowGroupID getParentGroup() const;
+
+		/**
+		 *  @brief  The getChildGroups method returns the IDs of the groups directly nested into this group.
+		 *  @param gIDs The set of WindowGroupIDs.
+		 */
+		void getChildGroups(std::unordered_set<WindowGroupID>& gIDs) const;
+
 #ifndef NO_MULTITHREADING
 		/**
 		 *  @brief  The setPoll method sets this group's event processing to POLL or WAIT for events.
@@ -116,19 +172,124 @@ namespace glfwm {
 		 */
 		bool isPolling() const;
 
+		/**
+		 *  @brief  The setTargetFrameRate method limits the rate at which this group's loop redraws its Windows while
+		 * polling, so that it sleeps between frames instead of spinning.
+		 *  @param framesPerSecond The maximum number of frames per second. 0 means no limit.
+		 *  @note   Windows set to update are still drawn as soon as possible. This has effect only when running
+		 * concurrently.
+		 */
+		void setTargetFrameRate(const double framesPerSecond);
+
+		/**
+		 *  @brief  The getTargetFrameRate method returns the maximum number of frames per second while polling.
+		 *  @return The target frame rate, or 0 if not limited.
+		 */
+		double getTargetFrameRate() const;
+
+		/**
+		 *  @brief  The setVSyncPacing method makes the frames drawn while polling follow a fixed cadence at the target
+		 * frame rate, as the vertical synchronization of a monitor does, instead of just keeping a minimum interval
+		 * between them. If no target frame rate has been set, the refresh rate of the primary monitor is used.
+		 *  @param vsync true for a fixed cadence, false for a minimum interval between frames.
+		 *  @note   This may only be called from the main thread.
+		 */
+		void setVSyncPacing(const bool vsync);
+
+		/**
+		 *  @brief  The isVSyncPacing method says if the frames drawn while polling follow a fixed cadence.
+		 *  @return true for a fixed cadence, false for a minimum interval between frames.
+		 */
+		bool isVSyncPacing() const;
+
 		/**
 		 *  @brief  The runLoopConcurrently method starts the execution of this group loop in another thread, if not yet
-		 * started.
+		 * started, or resumes it if paused.
 		 *  @note   Use notifyEvents, stop, isRunningConcurrently and join to sinchronize.
 		 */
 		void runLoopConcurrently();
 
 		/**
-		 *  @brief  The isRunningConcurrently method says if the loop is running on another thread.
-		 *  @return true if running concurrently, false otherwise.
+		 *  @brief  The runLoopOnExecutor method starts the execution of this group loop as a sequence of tasks on the
+		 * shared Executor, if not yet started, or resumes it if paused.
+		 *  @note   The Windows of this group are still drawn serially, but an idle group does not occupy any thread.
+		 * Use stop and stopAndWait to end it as with runLoopConcurrently.
+		 */
+		void runLoopOnExecutor();
+
+		/**
+		 *  @brief  The pause method suspends the loop running concurrently at the end of the current frame, keeping its
+		 * thread parked, and sinchronizes with it. Meanwhile, the group is processed by the calling thread as if not
+		 * running concurrently.
+		 *  @note   Pausing and resuming is much cheaper than stopping and restarting the loop.
+		 */
+		void pause();
+
+		/**
+		 *  @brief  The resume method restarts the loop suspended by pause.
+		 */
+		void resume();
+
+		/**
+		 *  @brief  The isPaused method says if the loop running concurrently is suspended.
+		 *  @return true if paused, false otherwise.
+		 */
+		bool isPaused() const;
+
+		/**
+		 *  @brief  The isRunningConcurrently method says if the loop is running on another thread, either dedicated or
+		 * belonging to the Executor.
+		 *  @return true if running concurrently, false otherwise or if paused.
 		 */
 		bool isRunningConcurrently() const;
 
+		/**
+		 *  @brief  The isRunningOnExecutor method says if the loop is running as a sequence of tasks on the Executor.
+		 *  @return true if running on the Executor, false otherwise.
+		 */
+		bool isRunningOnExecutor() const;
+
+		/**
+		 *  @brief  The setThreadName method sets the name of the thread running this group loop, as shown by
+		 * debuggers and profilers. The default is glfwm-g followed by the slot index of this group.
+		 *  @param name The name of the thread.
+		 *  @note   It takes effect at the next runLoopConcurrently.
+		 */
+		void setThreadName(const std::string& name);
+
+		/**
+		 *  @brief  The getThreadName method returns the name of the thread running this group loop.
+		 *  @return The name of the thread.
+		 */
+		std::string getThreadName() const;
+
+		/**
+		 *  @brief  The setThreadAffinity method pins the thread running this group loop to a set of CPUs.
+		 *  @param cpus The indices of the CPUs the thread is allowed to run on. Empty means any.
+		 *  @note   It takes effect at the next runLoopConcurrently. Not supported on macOS.
+		 */
+		void setThreadAffinity(const std::vector<unsigned int>& cpus);
+
+		/**
+		 *  @brief  The getThreadAffinity method returns the set of CPUs the thread running this group loop is pinned
+		 * to.
+		 *  @return The indices of the CPUs, or an empty set if not pinned.
+		 */
+		std::vector<unsigned int> getThreadAffinity() const;
+
+		/**
+		 *  @brief  The setThreadPriority method changes the scheduling priority of the thread running this group loop.
+		 *  @param priority The scheduling priority.
+		 *  @note   It takes effect at the next runLoopConcurrently. Raising the priority may require privileges.
+		 */
+		void setThreadPriority(const ThreadPriority priority);
+
+		/**
+		 *  @brief  The getThreadPriority method returns the scheduling priority of the thread running this group loop.
+		 *  @return The scheduling priority.
+		 */
+		ThreadPriority getThreadPriority() const;
+
 		/**
 		 *  @brief  The stop method breaks the execution of the loop running on another thread.
 		 *  @note   This does not sinchronize, just tells the thread to stop and returns immediately. See stopAndWait if
@@ -141,8 +302,30 @@ namespace glfwm {
 		 * with its ending.
 		 */
 		void stopAndWait();
+#else
+		/**
+		 *  @brief  The setTimeBudget method limits the time this group may spend drawing in each iteration of the main
+		 * loop, so that a heavy group does not delay the handling of events. The Windows left to draw are carried over
+		 * to the next iterations.
+		 *  @param seconds The maximum time per iteration, in seconds. 0 means no limit.
+		 *  @note   At least one Window is drawn per iteration. Synchronized presentations are never split.
+		 */
+		void setTimeBudget(const double seconds);
+
+		/**
+		 *  @brief  The getTimeBudget method returns the maximum time this group may spend drawing in each iteration of
+		 * the main loop.
+		 *  @return The time budget, in seconds, or 0 if not limited.
+		 */
+		double getTimeBudget() const;
 #endif
 
+		/**
+		 *  @brief  The hasPendingUpdates method says if some Windows of this group are waiting to be drawn.
+		 *  @return true if there are Windows to update, false otherwise.
+		 */
+		bool hasPendingUpdates() const;
+
 		/**
 		 *  @brief  The setWindowToUpdate method adds the window with ID wID to be updated.
 		 *  @param wID The ID of the Window to update.
@@ -155,12 +338,86 @@ namespace glfwm {
 		 */
 		void process();
 
+		/**
+		 *  @brief  The getStatistics method returns the achieved frame rate and the time spent idle by this group.
+		 *  @return The current statistics of this group.
+		 */
+		Statistics getStatistics() const;
+
+		/**
+		 *  @brief  The setSynchronizedPresentation method makes this group present its Windows together: all of them are
+		 * drawn and finished first, then their buffers are swapped back-to-back.
+		 *  @param synchronized true for presenting the Windows together, false for drawing and swapping each in turn.
+		 *  @param parallel     true for issuing the swaps from parallel threads, one per Window, false for issuing them
+		 * from the thread of this group. It is ignored if NO_MULTITHREADING is defined.
+		 *  @note   See Statistics::swapSkew for the measured time between the first and the last swap.
+		 */
+		void setSynchronizedPresentation(const bool synchronized, const bool parallel = false);
+
+		/**
+		 *  @brief  The isSynchronizedPresentation method says if this group presents its Windows together.
+		 *  @return true if the Windows are presented together, false otherwise.
+		 */
+		bool isSynchronizedPresentation() const;
+
 	  private:
 		/**
 		 *  @brief  The updateWindows method calls the draw method of the Windows in windowsToUpdate.
 		 */
 		void updateWindows();
 
+		/**
+		 *  @brief  The recordFrame method accounts a drawn frame in the statistics.
+		 *  @param busyTime The time spent drawing the frame, in seconds.
+		 */
+		void recordFrame(const double busyTime);
+
+		/**
+		 *  @brief  The recordStall method accounts a stall of this group's loop in the statistics.
+		 */
+		void recordStall();
+
+		/**
+		 *  @brief  The updateStatistics method publishes the statistics of the last period, if elapsed.
+		 *  @param now The current time.
+		 */
+		void updateStatistics(const std::chrono::steady_clock::time_point& now) const;
+
+		/**
+		 *  @brief  The presentTogether method draws all the Windows in windowsToDraw, waits for the completion of their
+		 * rendering and then swaps their buffers back-to-back.
+		 *  @return The number of Windows presented.
+		 */
+		size_t presentTogether();
+
+		/**
+		 *  @brief  The swapWindows method swaps the buffers of a subset of the Windows in windowsToPresent.
+		 *  @param first  The index of the first Window to swap.
+		 *  @param stride The distance between the indices of two consecutive Windows to swap.
+		 */
+		void swapWindows(const size_t first, const size_t stride);
+
+		/**
+		 *  @brief  The beginMeasure method starts measuring the CPU time spent drawing a Window, if requested by the
+		 * LoadBalancer.
+		 */
+		void beginMeasure();
+
+		/**
+		 *  @brief  The endMeasure method stops measuring the CPU time spent drawing a Window.
+		 *  @param wID The ID of the Window drawn.
+		 */
+		void endMeasure(const WindowID wID);
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  The moveWindows method moves the Windows in windowsToMove to their destination groups, releasing the
+		 * context current on the calling thread first, so that the destination threads can make it current. To be
+		 * called by the thread drawing this group, holding renderMutex.
+		 */
+		void moveWindows();
+#endif
+
 	  public:
 		/**
 		 *  @brief  The newGroupID static method books a new or an old & freed ID for WindowGroups.
@@ -182,6 +439,21 @@ namespace glfwm {
 		 */
 		static WindowGroupPointer getGroup(const WindowGroupID id);
 
+		/**
+		 *  @brief  The getGroupAtIndex static method returns a pointer to the WindowGroup stored in a slot.
+		 *  @param index The index of the slot, see getIndex.
+		 *  @return A pointer to the WindowGroup, if the slot is in use, or a null pointer.
+		 */
+		static WindowGroupPointer getGroupAtIndex(const size_t index);
+
+		/**
+		 *  @brief  The getIndex static method returns the index of the slot of a WindowGroup, which is small and
+		 * dense but, unlike its ID, reused as soon as the group is deleted.
+		 *  @param id The ID of the WindowGroup.
+		 *  @return The index of its slot.
+		 */
+		static size_t getIndex(const WindowGroupID id);
+
 		/**
 		 *  @brief  The getWindowGroup static method returns the ID of the group the Window identified by id belongs to.
 		 *  @param id The ID of the Window.
@@ -195,6 +467,13 @@ namespace glfwm {
 		 */
 		static void getAllWindowGroupIDs(std::unordered_set<WindowGroupID>& gIDs);
 
+		/**
+		 *  @brief  The waitForFramesInProgress static method blocks until all the groups have ended the frame they are
+		 * drawing, if any.
+		 *  @note   It must not be called while drawing.
+		 */
+		static void waitForFramesInProgress();
+
 		/**
 		 *  @brief  The getAllUngroupedWindowIDs static method returns the set of all the WindowIDs that are not
 		 * attached to any group.
@@ -202,6 +481,15 @@ namespace glfwm {
 		 */
 		static void getAllUngroupedWindowIDs(std::unordered_set<WindowID>& wIDs);
 
+		/**
+		 *  @brief  The addSubtreeGroups static method adds to a set the slot indices (see getIndex) of a group and of
+		 * all the groups nested, directly or not, into it.
+		 *  @param id   The ID of the group.
+		 *  @param gIDs The set of slot indices to add to.
+		 *  @note   The set of each group is kept precomputed, so this costs a union of bitsets.
+		 */
+		static void addSubtreeGroups(const WindowGroupID id, DynamicBitset& gIDs);
+
 		/**
 		 *  @brief  The deleteWindowGroup static method destroys and removes the WindowGroup at id.
 		 *  @param id The ID of the WindowGroup to delete.
@@ -213,6 +501,36 @@ namespace glfwm {
 		 */
 		static void deleteAllWindowGroups();
 
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  The setShareGroupLanes static method enables or disables the automatic attachment of each new
+		 * Window created by the WindowManager to a lane: a group running concurrently which holds all and only the
+		 * Windows sharing their contexts. This way, Windows sharing their contexts are never drawn by concurrent
+		 * threads, which would serialize on their shared mutex.
+		 *  @param lanes true for attaching new Windows to lanes, false otherwise.
+		 */
+		static void setShareGroupLanes(const bool lanes);
+
+		/**
+		 *  @brief  The isUsingShareGroupLanes static method says if new Windows are attached to lanes.
+		 *  @return true if attaching new Windows to lanes, false otherwise.
+		 */
+		static bool isUsingShareGroupLanes();
+
+		/**
+		 *  @brief  The getShareGroupLane static method returns the lane of a share group, creating and starting it if
+		 * it does not exist yet.
+		 *  @param contextShareID The share group of the contexts, see Window::getContextShareID.
+		 *  @return A pointer to the lane.
+		 */
+		static WindowGroupPointer getShareGroupLane(const size_t contextShareID);
+
+		/**
+		 *  @brief  The deleteEmptyShareGroupLanes static method destroys and removes the lanes without Windows.
+		 */
+		static void deleteEmptyShareGroupLanes();
+#endif
+
 	  private:
 		/**
 		 *  @brief  The WindoGroupID is the ID of this group, which is assigned at construction time and
@@ -226,12 +544,162 @@ namespace glfwm {
 		 */
 		std::unordered_set<WindowID> attachedWindows;
 
+		/**
+		 *  @brief  The ID of the group this group is nested into, or NoWindowGroupID. Guarded by globalMutex.
+		 */
+		WindowGroupID parentGroupID;
+
+		/**
+		 *  @brief  The IDs of the groups directly nested into this group. Guarded by globalMutex.
+		 */
+		std::unordered_set<WindowGroupID> childGroupIDs;
+
+		/**
+		 *  @brief  The slot indices of this group and of all the groups nested, directly or not, into it. Guarded by
+		 * globalMutex and recomputed by updateSubtreeGroups.
+		 */
+		DynamicBitset subtreeGroupIDs;
+
 		/**
 		 *  @brief  The set of windows that must be updated at a given time.
 		 */
 		std::unordered_set<WindowID> windowsToUpdate;
 
+		/**
+		 *  @brief  The set of windows being updated, swapped with windowsToUpdate at the beginning of each update so that
+		 * new windows to update can be added while drawing.
+		 */
+		std::unordered_set<WindowID> windowsBeingUpdated;
+
+		/**
+		 *  @brief  The windows to draw in the current update.
+		 */
+		std::vector<WindowID> windowsToDraw;
+
+		/**
+		 *  @brief  The windows not attached to this group set to update in the current update, forwarded to their own
+		 * groups.
+		 */
+		std::vector<WindowID> windowsToForward;
+
+		/**
+		 *  @brief  The Windows drawn and waiting to be swapped in a synchronized presentation.
+		 */
+		std::vector<WindowRef> windowsToPresent;
+
+		/**
+		 *  @brief  The times at which the swaps of windowsToPresent returned.
+		 */
+		std::vector<std::chrono::steady_clock::time_point> swapTimes;
+
+#ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  Flag telling whether the Windows are presented together.
+		 */
+		std::atomic<bool> synchronizedPresentation;
+
+		/**
+		 *  @brief  Flag telling whether the swaps of a synchronized presentation are issued from parallel threads.
+		 */
+		std::atomic<bool> parallelSwap;
+#else
+		/**
+		 *  @brief  Flag telling whether the Windows are presented together.
+		 */
+		bool synchronizedPresentation;
+
+		/**
+		 *  @brief  The maximum time spent drawing in each iteration of the main loop, in seconds. 0 means no limit.
+		 */
+		double timeBudget;
+#endif
+
+		/**
+		 *  @brief  The statistics published at the end of the last period.
+		 */
+		mutable Statistics statistics;
+
+		/**
+		 *  @brief  The start time of the current statistics period.
+		 */
+		mutable std::chrono::steady_clock::time_point statisticsPeriodStart;
+
+		/**
+		 *  @brief  The number of frames drawn in the current statistics period.
+		 */
+		mutable unsigned long long periodFrameCount;
+
+		/**
+		 *  @brief  The time spent drawing in the current statistics period, in seconds.
+		 */
+		mutable double periodBusyTime;
+
 #ifndef NO_MULTITHREADING
+		/**
+		 *  @brief  Mutex used to serialize the updates of this group, which are performed without holding mutex.
+		 */
+		std::mutex renderMutex;
+
+		/**
+		 *  @brief  The threads issuing the swaps of a synchronized presentation in parallel with the thread of this
+		 * group.
+		 */
+		std::vector<std::thread> presenters;
+
+		/**
+		 *  @brief  The barrier synchronizing the presenters with the thread of this group, at the beginning and at the
+		 * end of the swaps.
+		 */
+		std::unique_ptr<Barrier> presentBarrier;
+
+		/**
+		 *  @brief  Flag used to continue/break the execution of the presenters.
+		 */
+		std::atomic<bool> doPresent;
+
+		/**
+		 *  @brief  The number of threads swapping in parallel, presenters plus the thread of this group.
+		 */
+		size_t presentStride;
+
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent access to the statistics.
+		 */
+		mutable std::mutex statisticsMutex;
+
+		/**
+		 *  @brief  Flag telling whether the CPU time of the current update is being measured.
+		 */
+		bool measuring;
+
+		/**
+		 *  @brief  The CPU time of the thread at the beginning of the current measure.
+		 */
+		double measureStart;
+
+		/**
+		 *  @brief  The CPU times spent drawing each Window in the current update.
+		 */
+		std::vector<std::pair<WindowID, double>> measuredCPUTimes;
+
+		/**
+		 *  @brief  The CPU times spent drawing each Window since last collected by the LoadBalancer. Guarded by
+		 * statisticsMutex.
+		 */
+		std::unordered_map<WindowID, double> windowCPUTimes;
+
+		/**
+		 *  @brief  The CPU time spent updating this group since last collected by the LoadBalancer. Guarded by
+		 * statisticsMutex.
+		 */
+		double cpuTime;
+
+		/**
+		 *  @brief  The Windows the LoadBalancer is moving to other groups, with their destination, see moveWindows.
+		 * Guarded by mutex.
+		 */
+		std::vector<std::pair<WindowID, WindowGroupID>> windowsToMove;
+
 		/**
 		 *  @brief  Determines the event processing method: true for POLL, false for WAIT.
 		 */
@@ -263,31 +731,158 @@ namespace glfwm {
 		std::thread threadOfLoop;
 
 		/**
-		 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+		 *  @brief  The options applied to threadOfLoop when started.
+		 */
+		ThreadOptions threadOptions;
+
+		/**
+		 *  @brief  Flag telling whether the loop runs as a sequence of tasks on the Executor.
+		 */
+		std::atomic<bool> onExecutor;
+
+		/**
+		 *  @brief  Flag telling whether a task of this group has been submitted to the Executor and not yet finished.
+		 */
+		std::atomic<bool> taskScheduled;
+
+		/**
+		 *  @brief  Flag telling whether the loop running concurrently is suspended.
+		 */
+		std::atomic<bool> paused;
+
+		/**
+		 *  @brief  Flag telling whether threadOfLoop is parked because of pause. Guarded by mutex.
+		 */
+		bool parked;
+
+		/**
+		 *  @brief  Condition Variable used to sinchronize with the end of the last task submitted to the Executor, or
+		 * with threadOfLoop being parked.
+		 */
+		std::condition_variable taskConditionVariable;
+
+		/**
+		 *  @brief  The minimum interval between frames while polling, in seconds. 0 means no limit.
+		 */
+		std::atomic<double> frameInterval;
+
+		/**
+		 *  @brief  Flag telling whether frames follow a fixed cadence or just a minimum interval.
+		 */
+		std::atomic<bool> vsyncPacing;
+
+		/**
+		 *  @brief  The time at which the next frame is due while polling with a limited frame rate.
+		 */
+		std::chrono::steady_clock::time_point frameDeadline;
+
+		/**
+		 *  @brief  Flag telling whether a delayed task waking up this group for the next frame is pending on the
+		 * Executor.
 		 */
-		static std::recursive_mutex globalMutex;
+		std::atomic<bool> timerPending;
+
+		/**
+		 *  @brief  The ID of the delayed task waking up this group for the next frame.
+		 */
+		Executor::TimedTaskID timerID;
+
+		/**
+		 *  @brief  Mutex used to guarantee correct concurrent management of static activities. Lookups lock it shared,
+		 * creations, deletions and changes of membership exclusively. It is skipped by the main thread while
+		 * concurrency is not active, see Concurrency.
+		 */
+		static ElidableShardedMutex globalMutex;
+
+		/**
+		 *  @brief  Flag telling whether new Windows are attached to lanes.
+		 */
+		static std::atomic<bool> useShareGroupLanes;
+
+		/**
+		 *  @brief  The map between share groups and their lanes.
+		 */
+		static std::unordered_map<size_t, WindowGroupID> shareGroupLanes;
 
 		/**
 		 *  @brief  The concurrentLoop method is the function to be executed on another thread and that represents a
 		 * loop of event processing and drawing.
+		 *  @param options The options to apply to the thread.
 		 */
-		void concurrentLoop();
+		void concurrentLoop(const ThreadOptions options);
 
 		/**
 		 *  @brief  The waitEvents method puts the current thread to sleep if the Event queue is empty.
 		 */
 		void waitEvents();
+
+		/**
+		 *  @brief  The scheduleTask method submits a step of this group loop to the Executor, unless one is already
+		 * scheduled.
+		 */
+		void scheduleTask();
+
+		/**
+		 *  @brief  The executorTask method is a single step of the loop executed by the Executor: it draws the Windows
+		 * to update and submits itself again while there is still work to do.
+		 */
+		void executorTask();
+
+		/**
+		 *  @brief  The frameTimerTask method is the delayed task executed by the Executor when the next frame is due.
+		 */
+		void frameTimerTask();
+
+		/**
+		 *  @brief  The waitTasks method waits for the end of the step and of the delayed task of this group scheduled on
+		 * the Executor. To be called holding mutex.
+		 *  @param lock The lock of mutex.
+		 */
+		void waitTasks(std::unique_lock<std::mutex>& lock);
+
+		/**
+		 *  @brief  The advanceFrameDeadline method computes the time at which the frame after the current one is due.
+		 *  @param now The current time.
+		 */
+		void advanceFrameDeadline(const std::chrono::steady_clock::time_point& now);
+
+		/**
+		 *  @brief  The startPresenters method makes sure there are enough presenters to swap a given number of Windows
+		 * in parallel.
+		 *  @param count The number of presenters required.
+		 */
+		void startPresenters(const size_t count);
+
+		/**
+		 *  @brief  The stopPresenters method stops and joins the presenters.
+		 */
+		void stopPresenters();
+
+		/**
+		 *  @brief  The presenterLoop method is the function executed by each presenter.
+		 *  @param index The index of the presenter.
+		 */
+		void presenterLoop(const size_t index);
 #endif
 
 		/**
-		 *  @brief  The container of WindowGroups.
+		 *  @brief  The updateSubtreeGroups static method recomputes the set of nested groups of each group, after a
+		 * change of the hierarchy.
+		 */
+		static void updateSubtreeGroups();
+
+		/**
+		 *  @brief  The mapWindow static method records the WindowGroup a Window is attached to, both in windowGroupMap
+		 * and in the Window itself for lock-free lookups.
+		 *  @param wID The ID of the Window.
+		 *  @param gID The ID of the group, or NoWindowGroupID.
 		 */
-		static std::deque<WindowGroupPointer> windowGroups;
+		static void mapWindow(const WindowID wID, const WindowGroupID gID);
 
 		/**
-		 *  @brief  The container for reusing freed WindowGroupID. It is kept sorted.
+		 *  @brief  The container of WindowGroups, whose slots are identified by WindowGroupIDs.
 		 */
-		static std::deque<WindowGroupID> freedWindowGroupIDs;
+		static SlotMap<WindowGroupPointer> windowGroups;
 
 		/**
 		 *  @brief  The WindowGroupMap is a hash table used to map each Window to the WindowGroup it belongs to.
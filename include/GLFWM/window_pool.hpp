@@ -0,0 +1,110 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#ifndef GLFWM_WINDOW_POOL_HPP
+#define GLFWM_WINDOW_POOL_HPP
+
+#include <GLFWM/common.hpp>
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The WindowPool class keeps hidden the GLFW windows, and their contexts, of deleted Windows, so that new
+	 * Windows created with the same hints recycle them instead of creating new ones.
+	 *  @note   Only the Windows created by the WindowManager (whose hints are known, see WindowManager::setHint and
+	 * WindowConfig), not fullscreen and whose context is not shared are recycled. A recycled Window is a new one, with
+	 * a new ID and no handlers, drawables, tags nor group, but the state of its context is kept. All the methods may
+	 * only be called from the main thread.
+	 */
+	class WindowPool {
+	  public:
+		/**
+		 *  @brief  The Hints is a list of pairs of target hint and value, see WindowManager::setHint.
+		 */
+		using Hints = std::vector<std::pair<int, int>>;
+
+		/**
+		 *  @brief  The setCapacity static method sets the maximum number of GLFW windows kept, destroying the oldest
+		 * ones in excess.
+		 *  @param capacity The maximum number of windows. 0, the default, disables the pool.
+		 */
+		static void setCapacity(const size_t capacity);
+
+		/**
+		 *  @brief  The getCapacity static method returns the maximum number of GLFW windows kept.
+		 *  @return The maximum number of windows.
+		 */
+		static size_t getCapacity();
+
+		/**
+		 *  @brief  The getSize static method returns the number of GLFW windows kept.
+		 *  @return The number of windows.
+		 */
+		static size_t getSize();
+
+		/**
+		 *  @brief  The clear static method destroys all the GLFW windows kept.
+		 */
+		static void clear();
+
+	  private:
+		// The Window is friend for letting it recycle its GLFW window.
+		friend class Window;
+		// The WindowManager is friend for letting it warm the pool up.
+		friend class WindowManager;
+
+		/**
+		 *  @brief  The Entry struct stores a GLFW window kept, with the hints it was created with.
+		 */
+		struct Entry {
+			Hints hints;            ///< The hints, see makeKey.
+			GLFWwindow* glfwWindow; ///< The GLFW window, hidden.
+		};
+
+		/**
+		 *  @brief  The makeKey static method returns the hints determining whether a GLFW window can be recycled.
+		 *  @param hints The hints the window is created with, on top of the default ones.
+		 *  @return The hints sorted by target, the last value for each target, without the visibility.
+		 */
+		static Hints makeKey(const Hints& hints);
+
+		/**
+		 *  @brief  The acquire static method takes a GLFW window out of the pool.
+		 *  @param key The hints of the window, see makeKey.
+		 *  @return The GLFW window, hidden, or null if none has been created with the same hints.
+		 */
+		static GLFWwindow* acquire(const Hints& key);
+
+		/**
+		 *  @brief  The release static method puts a GLFW window into the pool, hiding it and resetting its callbacks
+		 * and properties.
+		 *  @param glfwWindow The GLFW window, whose user pointer must be null.
+		 *  @param key        The hints of the window, see makeKey.
+		 *  @return true if kept, false if the pool is full, in which case the window must be destroyed by the caller.
+		 */
+		static bool release(GLFWwindow* glfwWindow, const Hints& key);
+
+		/**
+		 *  @brief  The GLFW windows kept, oldest first.
+		 */
+		static std::deque<Entry> entries;
+
+		/**
+		 *  @brief  The maximum number of GLFW windows kept.
+		 */
+		static size_t capacity;
+	};
+
+}
+
+#endif
@@ -0,0 +1,244 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+
+#include <GLFWM/concurrency.hpp>
+
+#ifndef NO_MULTITHREADING
+namespace glfwm {
+
+	/**
+	 *  @brief  Flag telling whether the locks are being acquired.
+	 */
+	std::atomic<bool> Concurrency::active(false);
+
+	/**
+	 *  @brief  The number of users declared with enable, or joined, and not yet ended.
+	 */
+	std::atomic<size_t> Concurrency::users(0);
+
+	/**
+	 *  @brief  The main thread, see setMainThread.
+	 */
+	std::thread::id Concurrency::mainThreadID;
+
+	/**
+	 *  @brief  The mutex guarding waitCondition.
+	 */
+	std::mutex Concurrency::waitMutex;
+
+	/**
+	 *  @brief  The condition variable notified when the main thread leaves a section whose lock it skipped, while
+	 * concurrency is active.
+	 */
+	std::condition_variable Concurrency::waitCondition;
+
+	/**
+	 *  @brief  The locks skipped by the calling thread, i.e. the main one, innermost last.
+	 */
+	thread_local std::vector<Concurrency::ElidedLock> Concurrency::elidedLocks;
+
+	/**
+	 *  @brief  The use of the library by the calling thread, see join.
+	 */
+	thread_local Concurrency::User Concurrency::user;
+
+	/**
+	 *  @brief  Destructor, declares the end of the use, if joined.
+	 */
+	Concurrency::User::~User() {
+		if (joined)
+			Concurrency::disable();
+	}
+
+	/**
+	 *  @brief  The enable static method declares a new user of the library other than the main thread, e.g. before
+	 * starting a thread, so that concurrency is active by the time it calls the library.
+	 */
+	void Concurrency::enable() {
+		users.fetch_add(1);
+		active.store(true);
+	}
+
+	/**
+	 *  @brief  The disable static method declares that a user declared with enable is not going to call the library
+	 * any more, e.g. at the end of its thread.
+	 *  @note   Concurrency is switched off at the beginning of the next iteration of the main loop without users.
+	 */
+	void Concurrency::disable() { users.fetch_sub(1); }
+
+	/**
+	 *  @brief  The isActive static method says if the locks are being acquired.
+	 *  @return true if concurrency is active, false otherwise.
+	 */
+	bool Concurrency::isActive() { return active; }
+
+	/**
+	 *  @brief  The setMainThread static method sets the calling thread as the main one, allowed to skip the locks
+	 * while concurrency is not active. Called by WindowManager::init.
+	 */
+	void Concurrency::setMainThread() { mainThreadID = std::this_thread::get_id(); }
+
+	/**
+	 *  @brief  The quiesce static method switches concurrency off if there are no more users. To be called by the main
+	 * thread while holding no ElidableMutex, as at the beginning of each iteration of the main loop.
+	 */
+	void Concurrency::quiesce() {
+		if (!active.load(std::memory_order_relaxed) || std::this_thread::get_id() != mainThreadID
+		    || !elidedLocks.empty() || users.load() != 0)
+			return;
+		active.store(false);
+		// a thread joining meanwhile has already found concurrency active
+		if (users.load() != 0)
+			active.store(true);
+	}
+
+	/**
+	 *  @brief  The elide static method skips a lock, if allowed. Any thread other than the main one joins the users
+	 * and waits for the main thread to leave the sections of the mutex whose lock it skipped.
+	 *  @param mutex  The mutex to lock.
+	 *  @param shared true for a shared lock, false for an exclusive one.
+	 *  @return true if skipped, false if the mutex must be locked.
+	 */
+	bool Concurrency::elide(ElidableMutexBase* mutex, const bool shared) {
+		if (std::this_thread::get_id() != mainThreadID) {
+			if (mainThreadID != std::thread::id()) {
+				join();
+				wait(mutex, shared);
+			}
+			return false;
+		}
+		// only the main thread switches concurrency off, so it reads its own writes
+		if (active.load(std::memory_order_relaxed))
+			return false;
+		std::atomic<size_t>& elisions = shared ? mutex->sharedElisions : mutex->exclusiveElisions;
+		elisions.fetch_add(1);
+		// either this sees a thread joining meanwhile, or that thread sees the elision and waits for it
+		if (active.load()) {
+			elisions.fetch_sub(1);
+			return false;
+		}
+		ElidedLock l;
+		l.mutex = mutex;
+		l.shared = shared;
+		elidedLocks.push_back(l);
+		return true;
+	}
+
+	/**
+	 *  @brief  The tryElide static method skips an exclusive lock, if allowed, without waiting.
+	 *  @param mutex  The mutex to lock.
+	 *  @param elided Set to true if skipped, false if the mutex must be locked.
+	 *  @return false if the main thread is in a section of the mutex whose lock it skipped, true otherwise.
+	 */
+	bool Concurrency::tryElide(ElidableMutexBase* mutex, bool& elided) {
+		elided = false;
+		if (std::this_thread::get_id() == mainThreadID) {
+			elided = elide(mutex);
+			return true;
+		}
+		if (mainThreadID != std::thread::id())
+			join();
+		return mutex->exclusiveElisions.load() == 0 && mutex->sharedElisions.load() == 0;
+	}
+
+	/**
+	 *  @brief  The unelide static method ends a lock skipped by elide.
+	 *  @param mutex  The mutex to unlock.
+	 *  @param shared true for a shared lock, false for an exclusive one.
+	 *  @return true if the lock was skipped, false if the mutex must be unlocked.
+	 */
+	bool Concurrency::unelide(ElidableMutexBase* mutex, const bool shared) {
+		// the locks are usually released in reverse order
+		for (size_t i = elidedLocks.size(); i > 0; --i)
+			if (elidedLocks[i - 1].mutex == mutex && elidedLocks[i - 1].shared == shared) {
+				elidedLocks.erase(elidedLocks.begin() + (i - 1));
+				std::atomic<size_t>& elisions = shared ? mutex->sharedElisions : mutex->exclusiveElisions;
+				if (elisions.fetch_sub(1) == 1 && active.load()) {
+					// acquire ownership
+					{ std::lock_guard<std::mutex> lock(waitMutex); }
+					waitCondition.notify_all();
+				}
+				return true;
+			}
+		return false;
+	}
+
+	/**
+	 *  @brief  The join static method makes the calling thread a user of the library until its end, switching
+	 * concurrency on.
+	 */
+	void Concurrency::join() {
+		if (user.joined)
+			return;
+		user.joined = true;
+		enable();
+	}
+
+	/**
+	 *  @brief  The wait static method waits for the main thread to leave the sections of a mutex whose lock it
+	 * skipped, conflicting with the lock requested.
+	 *  @param mutex  The mutex to lock.
+	 *  @param shared true for a shared lock, false for an exclusive one.
+	 */
+	void Concurrency::wait(ElidableMutexBase* mutex, const bool shared) {
+		auto left = [mutex, shared]() {
+			return mutex->exclusiveElisions.load() == 0 && (shared || mutex->sharedElisions.load() == 0);
+		};
+		if (left())
+			return;
+		// acquire ownership
+		std::unique_lock<std::mutex> lock(waitMutex);
+		waitCondition.wait(lock, left);
+	}
+
+	/**
+	 *  @brief  The lock method locks all the shards, for writing.
+	 */
+	void ShardedRecursiveMutex::lock() {
+		// always in the same order, so that writers do not deadlock
+		for (size_t i = 0; i < ShardCount; ++i)
+			shards[i].mutex.lock();
+	}
+
+	/**
+	 *  @brief  The unlock method unlocks all the shards.
+	 */
+	void ShardedRecursiveMutex::unlock() {
+		for (size_t i = ShardCount; i > 0; --i)
+			shards[i - 1].mutex.unlock();
+	}
+
+	/**
+	 *  @brief  The lock_shared method locks the shard of the calling thread, for reading.
+	 */
+	void ShardedRecursiveMutex::lock_shared() { shards[getShardIndex()].mutex.lock(); }
+
+	/**
+	 *  @brief  The unlock_shared method unlocks the shard of the calling thread.
+	 */
+	void ShardedRecursiveMutex::unlock_shared() { shards[getShardIndex()].mutex.unlock(); }
+
+	/**
+	 *  @brief  The getShardIndex static method returns the shard of the calling thread, assigned round robin at its
+	 * first lock.
+	 *  @return The index of the shard.
+	 */
+	size_t ShardedRecursiveMutex::getShardIndex() {
+		static std::atomic<size_t> nextShard(0);
+		static thread_local const size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+		return index;
+	}
+
+}
+#endif
@@ -0,0 +1,130 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#include <GLFWM/contention_detector.hpp>
+
+#ifndef NO_MULTITHREADING
+namespace glfwm {
+
+	namespace {
+		/**
+		 *  @brief  The group whose Windows the current thread is drawing.
+		 */
+		thread_local WindowGroupID currentGroup = NoWindowGroupID;
+	}
+
+	/**
+	 *  @brief  Flag telling whether the waits are being recorded.
+	 */
+	std::atomic<bool> ContentionDetector::enabled(false);
+
+	/**
+	 *  @brief  The reports, keyed by share group, waiting group and owning group.
+	 */
+	std::map<std::tuple<size_t, WindowGroupID, WindowGroupID>, ContentionDetector::Report> ContentionDetector::reports;
+
+	/**
+	 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+	 */
+	std::mutex ContentionDetector::globalMutex;
+
+	/**
+	 *  @brief  The enable static method starts recording the waits.
+	 */
+	void ContentionDetector::enable() { enabled = true; }
+
+	/**
+	 *  @brief  The disable static method stops recording the waits.
+	 */
+	void ContentionDetector::disable() { enabled = false; }
+
+	/**
+	 *  @brief  The isEnabled static method says if the waits are being recorded.
+	 *  @return true if recording, false otherwise.
+	 */
+	bool ContentionDetector::isEnabled() { return enabled; }
+
+	/**
+	 *  @brief  The getReports static method returns the waits recorded so far.
+	 *  @param reports The list of reports, one for each share group and pair of groups.
+	 */
+	void ContentionDetector::getReports(std::vector<Report>& reports) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		reports.clear();
+		for (auto& r : ContentionDetector::reports)
+			reports.push_back(r.second);
+	}
+
+	/**
+	 *  @brief  The reset static method discards the waits recorded so far.
+	 */
+	void ContentionDetector::reset() {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		reports.clear();
+	}
+
+	/**
+	 *  @brief  The setCurrentGroup static method sets the group whose Windows the calling thread is drawing.
+	 *  @param id The ID of the group, or NoWindowGroupID.
+	 *  @return The ID of the group previously set.
+	 */
+	WindowGroupID ContentionDetector::setCurrentGroup(const WindowGroupID id) {
+		const WindowGroupID previous = currentGroup;
+		currentGroup = id;
+		return previous;
+	}
+
+	/**
+	 *  @brief  The getCurrentGroup static method returns the group whose Windows the calling thread is drawing.
+	 *  @return The ID of the group, or NoWindowGroupID.
+	 */
+	WindowGroupID ContentionDetector::getCurrentGroup() { return currentGroup; }
+
+	/**
+	 *  @brief  The recordWait static method records a wait for the contexts of a share group.
+	 *  @param contextShareID The share group of the contexts.
+	 *  @param owningGroupID  The group that held the contexts.
+	 *  @param waitTime       The time waited, in seconds.
+	 *  @note   Waits between threads drawing for the same group are not recorded. A warning is printed the first time
+	 * a pair of groups contend for a share group.
+	 */
+	void ContentionDetector::recordWait(const size_t contextShareID,
+	                                    const WindowGroupID owningGroupID,
+	                                    const double waitTime) {
+		const WindowGroupID waitingGroupID = currentGroup;
+		if (waitingGroupID == owningGroupID)
+			return;
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		std::map<std::tuple<size_t, WindowGroupID, WindowGroupID>, Report>::iterator it = reports.find(
+		    std::make_tuple(contextShareID, waitingGroupID, owningGroupID));
+		if (it == reports.end()) {
+			Report r;
+			r.contextShareID = contextShareID;
+			r.waitingGroupID = waitingGroupID;
+			r.owningGroupID = owningGroupID;
+			r.waitCount = 0;
+			r.waitTime = 0.0;
+			it = reports.insert(std::make_pair(std::make_tuple(contextShareID, waitingGroupID, owningGroupID), r)).first;
+			if (waitingGroupID != NoWindowGroupID && owningGroupID != NoWindowGroupID)
+				std::cout << "Warning. WindowGroups " << waitingGroupID << " and " << owningGroupID
+				          << " contend for Windows sharing their contexts: attach them to the same group." << std::endl;
+		}
+		it->second.waitCount++;
+		it->second.waitTime += waitTime;
+	}
+
+}
+#endif
@@ -0,0 +1,374 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#include <GLFWM/concurrency.hpp>
+#include <GLFWM/executor.hpp>
+
+#ifndef NO_MULTITHREADING
+namespace glfwm {
+
+	namespace {
+		/**
+		 *  @brief  The index of the worker running on the current thread, or the maximum value for threads not
+		 * belonging to the Executor.
+		 */
+		thread_local size_t currentWorker = std::numeric_limits<size_t>::max();
+	}
+
+	/**
+	 *  @brief  The queues of the worker threads.
+	 */
+	std::vector<std::unique_ptr<Executor::Worker>> Executor::workers;
+
+	/**
+	 *  @brief  The worker threads.
+	 */
+	std::vector<std::thread> Executor::threads;
+
+	/**
+	 *  @brief  The number of tasks queued and not yet taken by any worker.
+	 */
+	std::atomic<size_t> Executor::pendingTasks(0);
+
+	/**
+	 *  @brief  The index of the next worker to queue a task submitted from outside the pool.
+	 */
+	std::atomic<size_t> Executor::nextWorker(0);
+
+	/**
+	 *  @brief  Flag used to continue/break the execution of the worker threads.
+	 */
+	std::atomic<bool> Executor::doRun(false);
+
+	/**
+	 *  @brief  The number of times the worker threads have been started.
+	 */
+	std::atomic<size_t> Executor::runCount(0);
+
+	/**
+	 *  @brief  The delayed tasks, sorted by the time they are due.
+	 */
+	std::multimap<Executor::TimePoint, Executor::TimedTask> Executor::timedTasks;
+
+	/**
+	 *  @brief  The number of delayed tasks, used to avoid locking when there are none.
+	 */
+	std::atomic<size_t> Executor::timedTaskCount(0);
+
+	/**
+	 *  @brief  The ID of the next delayed task.
+	 */
+	Executor::TimedTaskID Executor::nextTimedTaskID = 0;
+
+	/**
+	 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+	 */
+	std::mutex Executor::globalMutex;
+
+	/**
+	 *  @brief  Condition Variable used by idle workers to wait for tasks.
+	 */
+	std::condition_variable Executor::conditionVariable;
+
+	/**
+	 *  @brief  The start static method starts the worker threads, if not yet started.
+	 *  @param threadCount The number of worker threads. 0 means as many as the hardware concurrency.
+	 *  @note   It is not necessary to call this method: submit starts the workers when needed.
+	 */
+	void Executor::start(const size_t threadCount) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		startWorkers(threadCount);
+	}
+
+	/**
+	 *  @brief  The startWorkers static method starts the worker threads, if not yet started. To be called while
+	 * holding globalMutex.
+	 *  @param threadCount The number of worker threads. 0 means as many as the hardware concurrency.
+	 */
+	void Executor::startWorkers(const size_t threadCount) {
+		// while stopping, the tasks are queued to the old workers, and discarded
+		if (doRun || !threads.empty())
+			return;
+		size_t count = threadCount;
+		if (count == 0)
+			count = std::thread::hardware_concurrency();
+		if (count == 0)
+			count = 2;
+		workers.clear();
+		for (size_t i = 0; i < count; ++i)
+			workers.emplace_back(new Worker());
+		pendingTasks = 0;
+		runCount++;
+		doRun = true;
+		for (size_t i = 0; i < count; ++i) {
+			// the tasks may use the library
+			Concurrency::enable();
+			threads.emplace_back(&Executor::workerLoop, i);
+		}
+	}
+
+	/**
+	 *  @brief  The stop static method stops and joins the worker threads. The tasks not yet executed are discarded.
+	 *  @note   The WindowGroups running on this Executor stop drawing, and can be stopped afterwards, as can be the
+	 * LoadBalancer, which must be enabled again.
+	 */
+	void Executor::stop() {
+		{
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(globalMutex);
+			if (!doRun)
+				return;
+			doRun = false;
+		}
+		conditionVariable.notify_all();
+		// the workers are not started again until these are cleared, see startWorkers
+		for (auto& t : threads)
+			t.join();
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		threads.clear();
+		workers.clear();
+		pendingTasks = 0;
+		timedTasks.clear();
+		timedTaskCount = 0;
+	}
+
+	/**
+	 *  @brief  The isRunning static method says if the worker threads have been started.
+	 *  @return true if the workers are running, false otherwise.
+	 */
+	bool Executor::isRunning() { return doRun; }
+
+	/**
+	 *  @brief  The getRunCount static method returns how many times the worker threads have been started, so that the
+	 * owners of tasks can tell whether a stop has discarded them meanwhile.
+	 *  @return The number of starts.
+	 */
+	size_t Executor::getRunCount() { return runCount; }
+
+	/**
+	 *  @brief  The getThreadCount static method returns the number of worker threads currently running.
+	 *  @return The number of worker threads.
+	 */
+	size_t Executor::getThreadCount() {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		return threads.size();
+	}
+
+	/**
+	 *  @brief  The submit static method queues a task to be executed by one of the worker threads.
+	 *  @param task The task to execute.
+	 *  @note   If called from a worker thread, the task is queued to that worker, otherwise the workers are chosen in
+	 * round-robin. Idle workers steal queued tasks from busy ones.
+	 */
+	void Executor::submit(Task task) {
+		{
+			// acquire ownership, so that the workers are not stopped meanwhile and can not miss the notification
+			std::lock_guard<std::mutex> lock(globalMutex);
+			startWorkers(0);
+			size_t index = currentWorker;
+			if (index >= workers.size())
+				index = nextWorker++ % workers.size();
+			// acquire ownership
+			std::lock_guard<std::mutex> workerLock(workers[index]->mutex);
+			pendingTasks++;
+			workers[index]->tasks.push_back(std::move(task));
+		}
+		conditionVariable.notify_one();
+	}
+
+	/**
+	 *  @brief  The submitAt static method queues a task to be executed by one of the worker threads not before a given
+	 * time.
+	 *  @param time The time at which the task is due.
+	 *  @param task The task to execute.
+	 *  @return The ID of the delayed task, which can be used to cancel it.
+	 */
+	Executor::TimedTaskID Executor::submitAt(const TimePoint& time, Task task) {
+		TimedTaskID id;
+		{
+			// acquire ownership, so that the workers are not stopped meanwhile and can not miss the notification
+			std::lock_guard<std::mutex> lock(globalMutex);
+			startWorkers(0);
+			id = nextTimedTaskID++;
+			TimedTask tt;
+			tt.id = id;
+			tt.task = std::move(task);
+			timedTasks.insert(std::make_pair(time, std::move(tt)));
+			timedTaskCount++;
+		}
+		// wake up an idle worker, so that it waits for the right amount of time
+		conditionVariable.notify_one();
+		return id;
+	}
+
+	/**
+	 *  @brief  The cancel static method removes a delayed task, if not yet started.
+	 *  @param id The ID of the delayed task to cancel.
+	 *  @return true if the task has been removed, false if it has already been started or it does not exist.
+	 */
+	bool Executor::cancel(const TimedTaskID id) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		for (auto it = timedTasks.begin(); it != timedTasks.end(); ++it)
+			if (it->second.id == id) {
+				timedTasks.erase(it);
+				timedTaskCount--;
+				return true;
+			}
+		return false;
+	}
+
+	/**
+	 *  @brief  The parallelFor static method runs a function for each index in [0, count) on the worker threads, the
+	 * calling thread included, and returns when all the calls have returned.
+	 *  @param count The number of indices.
+	 *  @param job   The function, called once per index, possibly concurrently.
+	 *  @note   The calling thread takes indices too, so this may be called from a task and completes even if the
+	 * workers are busy. The first exception thrown by the function is rethrown, after all the calls have returned.
+	 */
+	void Executor::parallelFor(const size_t count, const std::function<void(size_t)>& job) {
+		if (count == 0)
+			return;
+		if (count == 1) {
+			job(0);
+			return;
+		}
+		size_t helpers;
+		{
+			// acquire ownership, so that the workers are not stopped meanwhile
+			std::lock_guard<std::mutex> lock(globalMutex);
+			startWorkers(0);
+			helpers = std::min(count - 1, threads.size());
+		}
+		// the helpers starting late find no index left, but may still refer to the state
+		std::shared_ptr<ParallelFor> p = std::make_shared<ParallelFor>();
+		p->job = job;
+		p->count = count;
+		for (size_t i = 0; i < helpers; ++i)
+			submit([p]() { runParallelFor(*p); });
+		runParallelFor(*p);
+		std::unique_lock<std::mutex> lock(p->mutex);
+		p->finished.wait(lock, [&p]() { return p->done == p->count; });
+		if (p->error)
+			std::rethrow_exception(p->error);
+	}
+
+	/**
+	 *  @brief  The runParallelFor static method takes the indices of a call to parallelFor until none is left.
+	 *  @param p The state of the call.
+	 */
+	void Executor::runParallelFor(ParallelFor& p) {
+		for (size_t i = p.next++; i < p.count; i = p.next++) {
+			try {
+				p.job(i);
+			} catch (...) {
+				// acquire ownership
+				std::lock_guard<std::mutex> lock(p.mutex);
+				if (!p.error)
+					p.error = std::current_exception();
+			}
+			if (++p.done == p.count) {
+				// synchronize with the caller going to wait, so that the notification can not be lost
+				{ std::lock_guard<std::mutex> lock(p.mutex); }
+				p.finished.notify_all();
+			}
+		}
+	}
+
+	/**
+	 *  @brief  The workerLoop static method is the function executed by each worker thread.
+	 *  @param index The index of the worker.
+	 */
+	void Executor::workerLoop(const size_t index) {
+		currentWorker = index;
+		ThreadOptions options;
+		options.name = "glfwm-x" + std::to_string(index);
+		options.applyToCurrentThread();
+		Task task;
+		while (doRun) {
+			if (popTimedTask(task) || popTask(index, task)) {
+				task();
+				task = nullptr;
+				continue;
+			}
+			// go to sleep until a task is submitted or the first delayed task is due
+			std::unique_lock<std::mutex> lock(globalMutex);
+			if (!doRun || pendingTasks > 0)
+				continue;
+			if (timedTasks.empty())
+				conditionVariable.wait(lock);
+			else
+				conditionVariable.wait_until(lock, timedTasks.begin()->first);
+		}
+		currentWorker = std::numeric_limits<size_t>::max();
+		Concurrency::disable();
+	}
+
+	/**
+	 *  @brief  The popTask static method takes the next task of the worker at index, or steals one from another
+	 * worker.
+	 *  @param index The index of the worker looking for a task.
+	 *  @param task  The output task.
+	 *  @return true if a task has been found, false otherwise.
+	 */
+	bool Executor::popTask(const size_t index, Task& task) {
+		// first, look at the own queue, oldest task first, so that a task submitting itself again, as a WindowGroup
+		// step does, lets the others run
+		{
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(workers[index]->mutex);
+			if (!workers[index]->tasks.empty()) {
+				task = std::move(workers[index]->tasks.front());
+				workers[index]->tasks.pop_front();
+				pendingTasks--;
+				return true;
+			}
+		}
+		// then, steal the oldest task of another worker
+		for (size_t i = 1; i < workers.size(); ++i) {
+			Worker& victim = *workers[(index + i) % workers.size()];
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.tasks.empty()) {
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				pendingTasks--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 *  @brief  The popTimedTask static method takes the first delayed task, if due.
+	 *  @param task The output task.
+	 *  @return true if a due task has been found, false otherwise.
+	 */
+	bool Executor::popTimedTask(Task& task) {
+		if (timedTaskCount == 0)
+			return false;
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		if (timedTasks.empty() || timedTasks.begin()->first > std::chrono::steady_clock::now())
+			return false;
+		task = std::move(timedTasks.begin()->second.task);
+		timedTasks.erase(timedTasks.begin());
+		timedTaskCount--;
+		return true;
+	}
+
+}
+#endif
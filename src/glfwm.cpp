@@ -21,11 +21,82 @@ namespace glfwm {
 	double WindowManager::waitTimeout = std::numeric_limits<double>::infinity();
 #endif
 
+#ifndef NO_MULTITHREADING
+	MPSCQueue<WindowManager::Task> WindowManager::postedTasks;
+	std::atomic<bool> WindowManager::tasksPosted(false);
+	std::atomic<size_t> WindowManager::maxTasksPerIteration(64);
+	std::thread::id WindowManager::mainThreadID;
+#else
+	std::deque<WindowManager::Task> WindowManager::postedTasks;
+	bool WindowManager::tasksPosted = false;
+	size_t WindowManager::maxTasksPerIteration = 64;
+#endif
+	std::vector<WindowConfig::Hint> WindowManager::globalHints;
+	std::vector<WindowManager::CreationRequest> WindowManager::creationRequests;
+#ifndef NO_MULTITHREADING
+	std::mutex WindowManager::creationMutex;
+#endif
+
+	namespace {
+		/**
+		 *  @brief  The warnNotCreated function prints a warning for a Window which could not be created.
+		 *  @param error The exception thrown creating it.
+		 */
+		void warnNotCreated(const std::exception_ptr& error) {
+			try {
+				std::rethrow_exception(error);
+			} catch (const std::exception& e) {
+				std::cout << "Warning. Window not created: " << e.what() << std::endl;
+			} catch (...) {
+				std::cout << "Warning. Window not created." << std::endl;
+			}
+		}
+	}
+
 	/**
 	 *    @brief   The init static method initializes GLFW.
 	 *    @return true if correctly initialized, false otherwise.
 	 */
-	bool WindowManager::init() { return glfwInit(); }
+	bool WindowManager::init() {
+#ifndef NO_MULTITHREADING
+		mainThreadID = std::this_thread::get_id();
+		Concurrency::setMainThread();
+#endif
+		return glfwInit();
+	}
+
+	/**
+	 *  @brief  The init static method initializes GLFW and the WindowPool, creating some hidden windows to be recycled
+	 * by the first Windows created.
+	 *  @param windowPoolCapacity The maximum number of GLFW windows kept for recycling, see WindowPool.
+	 *  @param warmUpConfigs      The configurations of the windows to create, one each (repeat a configuration for
+	 * several windows). Those fullscreen, sharing their context or in excess of the capacity are not created.
+	 *  @return true if correctly initialized, false otherwise.
+	 */
+	bool WindowManager::init(const size_t windowPoolCapacity, const std::vector<WindowConfig>& warmUpConfigs) {
+		if (!init())
+			return false;
+		WindowPool::setCapacity(windowPoolCapacity);
+		bool warmed = false;
+		for (auto& c : warmUpConfigs) {
+			if (WindowPool::getSize() >= windowPoolCapacity)
+				break;
+			if (c.getMonitor() || c.getShare())
+				continue;
+			applyHints(c.getHints());
+			glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+			warmed = true;
+			GLFWwindow* w = glfwCreateWindow(c.getWidth(), c.getHeight(), c.getTitle().c_str(), nullptr, nullptr);
+			if (!w) {
+				std::cout << "Warning. GLFW window not created for the WindowPool." << std::endl;
+				continue;
+			}
+			WindowPool::release(w, WindowPool::makeKey(c.getHints()));
+		}
+		if (warmed)
+			applyHints(globalHints);
+		return true;
+	}
 
 	/**
 	 *    @brief  The setSwapInterval static method changes the number of screen updates to wait before swapping the
@@ -38,14 +109,28 @@ namespace glfwm {
 	 *  @brief  The resetDefaultHints static method resets all window hints to their default values.
 	 *  @note   This may only be called from the main thread.
 	 */
-	void WindowManager::resetDefaultHints() { glfwDefaultWindowHints(); }
+	void WindowManager::resetDefaultHints() {
+		globalHints.clear();
+		glfwDefaultWindowHints();
+	}
 
 	/**
 	 *  @brief  The setHint static method sets a target hint to a given value.
 	 *  @param target The target hint.
 	 *  @param value  The value to set to the hint.
 	 */
-	void WindowManager::setHint(const int target, const int value) { glfwWindowHint(target, value); }
+	void WindowManager::setHint(const int target, const int value) {
+		// recorded to be restored after creating windows from a WindowConfig
+		bool found = false;
+		for (auto& h : globalHints)
+			if (h.first == target) {
+				h.second = value;
+				found = true;
+			}
+		if (!found)
+			globalHints.push_back(WindowConfig::Hint(target, value));
+		glfwWindowHint(target, value);
+	}
 
 	/**
 	 *  @brief  The setPoll static method changes the current way of managing the event queue: process any event in the
@@ -87,6 +172,7 @@ namespace glfwm {
 	 *    @param monitor    A pointer to a monitor for fullscreen, or NULL otherwise.
 	 *    @param share      A pointer to another window to share its context with, or NULL otherwise.
 	 *    @return A pointer to the new created Window.
+	 *    @note   The window is recycled from the WindowPool if possible, assuming the hints have been set with setHint.
 	 */
 	WindowPointer WindowManager::createWindow(const int width,
 	                                          const int height,
@@ -94,9 +180,7 @@ namespace glfwm {
 	                                          const EventBaseType eventTypes,
 	                                          GLFWmonitor* monitor,
 	                                          const WindowPointer& share) {
-		WindowPointer w = Window::newWindow(width, height, title, monitor, share);
-		registerWindowCallbacks(w, eventTypes);
-		return w;
+		return newManagedWindow(width, height, title, eventTypes, monitor, share, globalHints);
 	}
 
 	/**
@@ -116,34 +200,148 @@ namespace glfwm {
 	                                          const EventType eventType,
 	                                          GLFWmonitor* monitor,
 	                                          const WindowPointer& share) {
-		return createWindow(width, height, title, static_cast<EventBaseType>(eventType));
+		return createWindow(width, height, title, static_cast<EventBaseType>(eventType), monitor, share);
 	}
 
+	/**
+	 *  @brief  The createWindow static method constructs a new Window as configured, hints included, and registers its
+	 * callbacks.
+	 *  @param config The configuration of the window.
+	 *  @return A pointer to the new created Window.
+	 *  @note   This may only be called from the main thread. The hints set with setHint are restored afterwards.
+	 */
+	WindowPointer WindowManager::createWindow(const WindowConfig& config) {
+		WindowPointer w;
+		applyHints(config.getHints());
+		try {
+			w = newManagedWindow(config.getWidth(),
+			                     config.getHeight(),
+			                     config.getTitle(),
+			                     config.getEventTypes(),
+			                     config.getMonitor(),
+			                     config.getShare(),
+			                     config.getHints());
+		} catch (...) {
+			applyHints(globalHints);
+			throw;
+		}
+		applyHints(globalHints);
+		return w;
+	}
+
+	/**
+	 *  @brief  The createWindowAsync static method requests the main thread to create a new Window as configured, see
+	 * createWindow, and returns immediately. It may be called from any thread.
+	 *  @param config   The configuration of the window.
+	 *  @param callback The function called from the main thread with the new Window, or with a null pointer if it
+	 * could not be created (a warning is printed). It may be empty.
+	 *  @note   The requests are batched: all those pending are served by a single iteration of mainLoop, setting the
+	 * hints only when they change from a window to the next. If called from the main thread, the window is created
+	 * immediately.
+	 */
+	void WindowManager::createWindowAsync(const WindowConfig& config, const WindowCallback& callback) {
+		CreationRequest request;
+		request.configs.push_back(config);
+		request.done = [callback](std::vector<WindowPointer>& windows, std::vector<std::exception_ptr>& errors) {
+			if (errors.front())
+				warnNotCreated(errors.front());
+			if (callback)
+				callback(windows.front());
+		};
+		requestWindows(std::move(request));
+	}
+
+	/**
+	 *  @brief  The createWindowsAsync static method requests the main thread to create several new Windows together,
+	 * see createWindowAsync.
+	 *  @param configs  The configurations of the windows.
+	 *  @param callback The function called from the main thread with the new Windows, in the order of configs, null for
+	 * those which could not be created (a warning is printed). It may be empty.
+	 */
+	void WindowManager::createWindowsAsync(const std::vector<WindowConfig>& configs, const WindowsCallback& callback) {
+		CreationRequest request;
+		request.configs = configs;
+		request.done = [callback](std::vector<WindowPointer>& windows, std::vector<std::exception_ptr>& errors) {
+			for (auto& e : errors)
+				if (e)
+					warnNotCreated(e);
+			if (callback)
+				callback(windows);
+		};
+		requestWindows(std::move(request));
+	}
+
+#ifndef NO_MULTITHREADING
+	/**
+	 *  @brief  The createWindowAsync static method requests the main thread to create a new Window as configured, see
+	 * createWindow, and returns immediately. It may be called from any thread.
+	 *  @param config The configuration of the window.
+	 *  @return The future Window, or the exception thrown creating it.
+	 *  @note   See createWindowAsync with a callback.
+	 */
+	std::future<WindowPointer> WindowManager::createWindowAsync(const WindowConfig& config) {
+		std::shared_ptr<std::promise<WindowPointer>> promise = std::make_shared<std::promise<WindowPointer>>();
+		std::future<WindowPointer> result = promise->get_future();
+		CreationRequest request;
+		request.configs.push_back(config);
+		request.done = [promise](std::vector<WindowPointer>& windows, std::vector<std::exception_ptr>& errors) {
+			if (errors.front())
+				promise->set_exception(errors.front());
+			else
+				promise->set_value(windows.front());
+		};
+		requestWindows(std::move(request));
+		return result;
+	}
+
+	/**
+	 *  @brief  The createWindowsAsync static method requests the main thread to create several new Windows together,
+	 * see createWindowAsync.
+	 *  @param configs The configurations of the windows.
+	 *  @return The future Windows, in the order of configs, null for those which could not be created (a warning is
+	 * printed).
+	 */
+	std::future<std::vector<WindowPointer>> WindowManager::createWindowsAsync(
+	    const std::vector<WindowConfig>& configs) {
+		std::shared_ptr<std::promise<std::vector<WindowPointer>>> promise =
+		    std::make_shared<std::promise<std::vector<WindowPointer>>>();
+		std::future<std::vector<WindowPointer>> result = promise->get_future();
+		CreationRequest request;
+		request.configs = configs;
+		request.done = [promise](std::vector<WindowPointer>& windows, std::vector<std::exception_ptr>& errors) {
+			for (auto& e : errors)
+				if (e)
+					warnNotCreated(e);
+			promise->set_value(windows);
+		};
+		requestWindows(std::move(request));
+		return result;
+	}
+#endif
+
 	/**
 	 *    @brief  The registerWindowCallbacks static method sets callbacks for window to handle events of type
 	 * eventTypes.
 	 *    @param window     The Window whose events must be handled with the callbacks to register.
 	 *    @param eventTypes A mask corresponding to the list of event types to register for callbacks.
+	 *    @note   The callbacks of position, size, focus, maximization, iconification, framebuffer size and content
+	 * scale are registered anyway, as they keep the properties cached by the window up to date (see Window::getState),
+	 * but their events are handled only if in eventTypes.
 	 */
 	void WindowManager::registerWindowCallbacks(WindowPointer& window, const EventBaseType eventTypes) {
-		if (eventTypes & EventType::WINDOW_POSITION)
-			glfwSetWindowPosCallback(window->glfwWindow, windowPositionCallback);
-		if (eventTypes & EventType::WINDOW_SIZE)
-			glfwSetWindowSizeCallback(window->glfwWindow, windowSizeCallback);
+		window->callbackEventTypes |= eventTypes;
+		// these are registered anyway, as they keep the cached properties of the window up to date
+		glfwSetWindowPosCallback(window->glfwWindow, windowPositionCallback);
+		glfwSetWindowSizeCallback(window->glfwWindow, windowSizeCallback);
+		glfwSetWindowFocusCallback(window->glfwWindow, windowFocusCallback);
+		glfwSetWindowMaximizeCallback(window->glfwWindow, windowMaximizeCallback);
+		glfwSetWindowIconifyCallback(window->glfwWindow, windowIconifyCallback);
+		glfwSetFramebufferSizeCallback(window->glfwWindow, windowFramebufferSizeCallback);
+		glfwSetWindowContentScaleCallback(window->glfwWindow, windowContentScaleCallback);
 		if (eventTypes & EventType::WINDOW_CLOSE)
 			glfwSetWindowCloseCallback(window->glfwWindow, windowCloseCallback);
 		if (eventTypes & EventType::WINDOW_REFRESH)
 			glfwSetWindowRefreshCallback(window->glfwWindow, windowRefreshCallback);
-		if (eventTypes & EventType::WINDOW_FOCUS)
-			glfwSetWindowFocusCallback(window->glfwWindow, windowFocusCallback);
-		if (eventTypes & EventType::WINDOW_MAXIMIZE)
-			glfwSetWindowMaximizeCallback(window->glfwWindow, windowMaximizeCallback);
-		if (eventTypes & EventType::WINDOW_ICONIFY)
-			glfwSetWindowIconifyCallback(window->glfwWindow, windowIconifyCallback);
-		if (eventTypes & EventType::FRAMEBUFFERSIZE)
-			glfwSetFramebufferSizeCallback(window->glfwWindow, windowFramebufferSizeCallback);
-		if (eventTypes & EventType::CONTENTSCALE)
-			glfwSetWindowContentScaleCallback(window->glfwWindow, windowContentScaleCallback);
 		if (eventTypes & EventType::CHAR)
 			glfwSetCharCallback(window->glfwWindow, inputCharCallback);
 		if (eventTypes & EventType::CHARMOD)
@@ -186,16 +384,49 @@ namespace glfwm {
 	void WindowManager::mainLoop() {
 		WindowGroupID gID;
 		WindowGroupPointer g;
-		WindowPointer w;
+		WindowRef w;
 		std::unordered_set<WindowGroupID> gIDs;
 		std::unordered_set<WindowID> wIDs;
+		// sets of groups are keyed by slot index, see WindowGroup::getIndex
+		DynamicBitset groupsToProcess;
+		DynamicBitset subtreeGroupIDs;
+		// the windows not attached to any group are drawn by the main loop, prepared together first
+		std::vector<WindowID> ungroupedWindowsToDraw;
+		FrameInfo ungroupedFrame;
+#ifdef NO_MULTITHREADING
+		DynamicBitset pendingGroups;
+		size_t firstGroup = 0;
+#endif
+
+#ifndef NO_MULTITHREADING
+		// beat the main loop's heartbeat while drawing and handling events
+		Watchdog::setCurrentLoop(NoWindowGroupID);
+#endif
 
 		// ensure first rendering
 		UpdateMap::setToUpdate(AllWindowGroupIDs, AllWindowIDs);
 
 		// do loop
 		do {
-			// update groups and windows
+#ifndef NO_MULTITHREADING
+			// stop locking if no other thread is using the library any more
+			Concurrency::quiesce();
+#endif
+			// release the Windows deleted so far, as soon as no frame can be borrowing them
+			Window::reclaimRetiredWindows();
+			// run the functions posted by other threads
+			runPostedTasks();
+			// apply the titles, positions, sizes and opacities set meanwhile, from any thread
+			Window::applyPendingProperties();
+
+			// collect groups and windows to update, so that each group is processed once even when reached by
+			// several notifications
+			groupsToProcess.clear();
+#ifdef NO_MULTITHREADING
+			// groups out of time budget in the previous iteration have windows left to draw
+			groupsToProcess |= pendingGroups;
+			pendingGroups.clear();
+#endif
 			while (!UpdateMap::empty()) {
 				UpdateMap::popGroup(gID, wIDs);
 				if (gID == AllWindowGroupIDs) {
@@ -204,53 +435,95 @@ namespace glfwm {
 						g = WindowGroup::getGroup(id);
 						if (g) {
 							g->setWindowToUpdate(WholeGroupWindowIDs);
-							g->process();
+							groupsToProcess.set(WindowGroup::getIndex(id));
 						}
 					}
 					WindowGroup::getAllUngroupedWindowIDs(wIDs);
-					for (auto id : wIDs) {
-						w = Window::getWindow(id);
-						if (w) {
-							w->makeContextCurrent();
-							w->draw();
-							w->swapBuffers();
-							w->doneCurrentContext();
-						}
-					}
+					ungroupedWindowsToDraw.insert(ungroupedWindowsToDraw.end(), wIDs.begin(), wIDs.end());
 				} else {
 					g = WindowGroup::getGroup(gID);
 					if (g) {
 						for (auto& id : wIDs)
 							g->setWindowToUpdate(id);
-						g->process();
+						groupsToProcess.set(WindowGroup::getIndex(gID));
+						// fan out to the nested groups
+						if (wIDs.count(WholeGroupWindowIDs) || wIDs.count(AllWindowIDs)) {
+							subtreeGroupIDs.clear();
+							WindowGroup::addSubtreeGroups(gID, subtreeGroupIDs);
+							subtreeGroupIDs.reset(WindowGroup::getIndex(gID));
+							for (size_t i = subtreeGroupIDs.findNext(0); i != DynamicBitset::npos;
+							     i = subtreeGroupIDs.findNext(i + 1)) {
+								g = WindowGroup::getGroupAtIndex(i);
+								if (g)
+									g->setWindowToUpdate(WholeGroupWindowIDs);
+							}
+							groupsToProcess |= subtreeGroupIDs;
+						}
 					} else {
-						gIDs.clear();
 						for (auto& id : wIDs) {
 							g = WindowGroup::getGroup(WindowGroup::getWindowGroup(id));
 							if (g) {
 								g->setWindowToUpdate(id);
-								gIDs.insert(g->getID());
-							} else {
-								w = Window::getWindow(id);
-								if (w) {
-									w->makeContextCurrent();
-									w->draw();
-									w->swapBuffers();
-									w->doneCurrentContext();
-								}
-							}
-						}
-						for (auto id : gIDs) {
-							g = WindowGroup::getGroup(id);
-							if (g)
-								g->process();
+								groupsToProcess.set(WindowGroup::getIndex(g->getID()));
+							} else
+								ungroupedWindowsToDraw.push_back(id);
 						}
 					}
 				}
 			}
+			if (!ungroupedWindowsToDraw.empty()) {
+				// each window once, as a window can not be prepared twice at the same time
+				std::sort(ungroupedWindowsToDraw.begin(), ungroupedWindowsToDraw.end());
+				ungroupedWindowsToDraw.erase(std::unique(ungroupedWindowsToDraw.begin(), ungroupedWindowsToDraw.end()),
+				                             ungroupedWindowsToDraw.end());
+				ungroupedFrame.time = std::chrono::steady_clock::now();
+				Window::prepareWindows(ungroupedWindowsToDraw, ungroupedFrame);
+				for (auto id : ungroupedWindowsToDraw) {
+					w = Window::borrowWindow(id);
+					if (w) {
+						w->makeContextCurrent();
+						w->draw();
+						w->swapBuffers();
+						w->doneCurrentContext();
+					}
+				}
+				ungroupedWindowsToDraw.clear();
+				++ungroupedFrame.frameIndex;
+			}
+#ifndef NO_MULTITHREADING
+			for (size_t i = groupsToProcess.findNext(0); i != DynamicBitset::npos; i = groupsToProcess.findNext(i + 1)) {
+				g = WindowGroup::getGroupAtIndex(i);
+				if (g)
+					g->process();
+			}
+#else
+			// round-robin: each iteration starts from the group after the one that started the previous iteration
+			size_t startedGroup = DynamicBitset::npos;
+			for (size_t pass = 0; pass < 2; ++pass)
+				for (size_t i = groupsToProcess.findNext(pass == 0 ? firstGroup : 0);
+				     i != DynamicBitset::npos && (pass == 0 || i < firstGroup);
+				     i = groupsToProcess.findNext(i + 1)) {
+					if (startedGroup == DynamicBitset::npos)
+						startedGroup = i;
+					g = WindowGroup::getGroupAtIndex(i);
+					if (g) {
+						g->process();
+						if (g->hasPendingUpdates())
+							pendingGroups.set(i);
+					}
+				}
+			if (startedGroup != DynamicBitset::npos)
+				firstGroup = startedGroup + 1;
+#endif
 
 			// manage events
-			if (waitTimeout == 0.0) {
+#ifdef NO_MULTITHREADING
+			if (!pendingGroups.none() && waitTimeout != 0.0) {
+				// windows are still waiting to be drawn: do not block
+				glfwPollEvents();
+			} else
+#endif
+			    if (waitTimeout == 0.0) {
 				glfwPollEvents();
 				UpdateMap::setToUpdate(AllWindowGroupIDs, AllWindowIDs);
 			} else if (waitTimeout == std::numeric_limits<double>::infinity()) {
@@ -267,6 +540,10 @@ namespace glfwm {
 					g->detachWindow(id);
 				Window::deleteWindow(id);
 			}
+#ifndef NO_MULTITHREADING
+			if (!wIDs.empty() && WindowGroup::isUsingShareGroupLanes())
+				WindowGroup::deleteEmptyShareGroupLanes();
+#endif
 
 		} while (Window::isAnyWindowOpen());
 	}
@@ -276,490 +553,739 @@ namespace glfwm {
 	 *    @note   Call this method after mainLoop.
 	 */
 	void WindowManager::terminate() {
+#ifndef NO_MULTITHREADING
+		Watchdog::stop();
+		LoadBalancer::disable();
+#endif
 		WindowGroup::deleteAllWindowGroups();
+#ifndef NO_MULTITHREADING
+		Executor::stop();
+#endif
+		// the windows are destroyed rather than kept
+		WindowPool::setCapacity(0);
 		Window::deleteAllWindows();
+		// discard the functions not run
+#ifndef NO_MULTITHREADING
+		Task task;
+		while (!postedTasks.empty())
+			postedTasks.pop(task);
+#else
+		postedTasks.clear();
+#endif
+		tasksPosted = false;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(creationMutex);
+#endif
+			// the futures of the requests not served get a broken promise
+			creationRequests.clear();
+		}
 		glfwTerminate();
 	}
 
+	/**
+	 *  @brief  The isMainThread static method says if the calling thread is the main thread, i.e. the one which called
+	 * init.
+	 *  @return true if called from the main thread, false otherwise.
+	 */
+	bool WindowManager::isMainThread() {
+#ifndef NO_MULTITHREADING
+		return std::this_thread::get_id() == mainThreadID;
+#else
+		return true;
+#endif
+	}
+
+	/**
+	 *  @brief  The post static method queues a function to be run by the main thread during mainLoop, and returns
+	 * immediately. It may be called from any thread, e.g. for the GLFW functions restricted to the main thread.
+	 *  @param task The function to run.
+	 *  @note   The functions are run in the order they are posted, at most getMaxTasksPerIteration per iteration of
+	 * mainLoop. Exceptions thrown by them are reported as warnings. Those left when terminating are discarded.
+	 */
+	void WindowManager::post(Task task) {
+#ifndef NO_MULTITHREADING
+		postedTasks.push(std::move(task));
+		// wake up the main loop once until it runs the functions
+		if (!tasksPosted.exchange(true))
+			glfwPostEmptyEvent();
+#else
+		postedTasks.push_back(std::move(task));
+		// wake up the main loop once until it runs the functions
+		if (!tasksPosted) {
+			tasksPosted = true;
+			glfwPostEmptyEvent();
+		}
+#endif
+	}
+
+	/**
+	 *  @brief  The setMaxTasksPerIteration static method bounds the number of posted functions run by each iteration
+	 * of mainLoop, so that a burst of them does not delay event handling. The others are left for the next iterations.
+	 *  @param count The maximum number of functions per iteration. The default is 64.
+	 */
+	void WindowManager::setMaxTasksPerIteration(const size_t count) {
+		maxTasksPerIteration = std::max<size_t>(count, 1);
+	}
+
+	/**
+	 *  @brief  The getMaxTasksPerIteration static method returns the number of posted functions run by each iteration
+	 * of mainLoop at most.
+	 *  @return The maximum number of functions per iteration.
+	 */
+	size_t WindowManager::getMaxTasksPerIteration() { return maxTasksPerIteration; }
+
+	/**
+	 *  @brief  The runPostedTasks static method runs the functions posted to the main thread, at most
+	 * maxTasksPerIteration.
+	 */
+	void WindowManager::runPostedTasks() {
+		if (!tasksPosted)
+			return;
+		// functions posted from now on wake up the main loop again
+		tasksPosted = false;
+		const size_t maxCount = maxTasksPerIteration;
+		Task task;
+		size_t count = 0;
+		for (; count < maxCount; ++count) {
+#ifndef NO_MULTITHREADING
+			if (!postedTasks.pop(task))
+				break;
+#else
+			if (postedTasks.empty())
+				break;
+			task = std::move(postedTasks.front());
+			postedTasks.pop_front();
+#endif
+			try {
+				task();
+			} catch (const std::exception& e) {
+				std::cout << "Warning. A function posted to the main thread threw: " << e.what() << std::endl;
+			}
+		}
+		// functions left for the next iteration: do not wait for events meanwhile
+		if (count == maxCount && !postedTasks.empty()) {
+			tasksPosted = true;
+			glfwPostEmptyEvent();
+		}
+	}
+
+	/**
+	 *  @brief  The requestWindows static method queues a request of creating Windows, and wakes up the main thread to
+	 * serve it.
+	 *  @param request The request.
+	 */
+	void WindowManager::requestWindows(CreationRequest request) {
+		if (isMainThread()) {
+			std::vector<CreationRequest> requests(1, std::move(request));
+			serveRequests(requests);
+			return;
+		}
+		bool first = false;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(creationMutex);
+#endif
+			first = creationRequests.empty();
+			creationRequests.push_back(std::move(request));
+		}
+		// a single function serves all the requests queued until it runs
+		if (first)
+			post(&WindowManager::createRequestedWindows);
+	}
+
+	/**
+	 *  @brief  The createRequestedWindows static method serves the pending requests of creating Windows.
+	 */
+	void WindowManager::createRequestedWindows() {
+		std::vector<CreationRequest> requests;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(creationMutex);
+#endif
+			requests.swap(creationRequests);
+		}
+		serveRequests(requests);
+	}
+
+	/**
+	 *  @brief  The serveRequests static method creates the Windows of some requests and then calls their functions.
+	 *  @param requests The requests.
+	 */
+	void WindowManager::serveRequests(std::vector<CreationRequest>& requests) {
+		std::vector<std::vector<WindowPointer>> windows(requests.size());
+		std::vector<std::vector<std::exception_ptr>> errors(requests.size());
+		const std::vector<WindowConfig::Hint>* hints = nullptr;
+		for (size_t i = 0; i < requests.size(); ++i)
+			for (auto& c : requests[i].configs) {
+				// set the hints only when they change from the previous window
+				if (!hints || *hints != c.getHints()) {
+					applyHints(c.getHints());
+					hints = &c.getHints();
+				}
+				try {
+					windows[i].push_back(newManagedWindow(c.getWidth(),
+					                                      c.getHeight(),
+					                                      c.getTitle(),
+					                                      c.getEventTypes(),
+					                                      c.getMonitor(),
+					                                      c.getShare(),
+					                                      c.getHints()));
+					errors[i].push_back(nullptr);
+				} catch (...) {
+					windows[i].push_back(nullptr);
+					errors[i].push_back(std::current_exception());
+				}
+			}
+		if (hints)
+			applyHints(globalHints);
+		// called once all the windows are created, as they may create windows or set hints themselves
+		for (size_t i = 0; i < requests.size(); ++i) {
+			if (!requests[i].done)
+				continue;
+			try {
+				requests[i].done(windows[i], errors[i]);
+			} catch (const std::exception& e) {
+				std::cout << "Warning. A function receiving created Windows threw: " << e.what() << std::endl;
+			}
+		}
+	}
+
+	/**
+	 *  @brief  The applyHints static method resets the window hints to their default values and then sets some.
+	 *  @param hints The hints to set.
+	 */
+	void WindowManager::applyHints(const std::vector<WindowConfig::Hint>& hints) {
+		glfwDefaultWindowHints();
+		for (auto& h : hints)
+			glfwWindowHint(h.first, h.second);
+	}
+
+	/**
+	 *  @brief  The newManagedWindow static method constructs a new Window, recycled from the WindowPool if
+	 * possible, and registers its callbacks.
+	 *  @param width      The window width.
+	 *  @param height     The window height.
+	 *  @param title      The window title.
+	 *  @param eventTypes A mask corresponding to the list of event types to register for callbacks.
+	 *  @param monitor    A pointer to a monitor for fullscreen, or NULL otherwise.
+	 *  @param share      A pointer to another window to share its context with, or NULL otherwise.
+	 *  @param hints      The hints currently set, on top of the default ones.
+	 *  @return A pointer to the new created Window.
+	 */
+	WindowPointer WindowManager::newManagedWindow(const int width,
+	                                              const int height,
+	                                              const std::string& title,
+	                                              const EventBaseType eventTypes,
+	                                              GLFWmonitor* monitor,
+	                                              const WindowPointer& share,
+	                                              const std::vector<WindowConfig::Hint>& hints) {
+		WindowPointer w = Window::newWindow(width, height, title, monitor, share, &hints);
+		registerWindowCallbacks(w, eventTypes);
+#ifndef NO_MULTITHREADING
+		if (WindowGroup::isUsingShareGroupLanes())
+			WindowGroup::getShareGroupLane(w->getContextShareID())->attachWindow(w->getID());
+#endif
+		return w;
+	}
+
 	// callbacks
 
 	void WindowManager::windowPositionCallback(GLFWwindow* glfwWindow, int x, int y) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Position event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
+		// keep the cached properties up to date, even if the event is not handled
+		Window::State s = w->getState();
+		s.x = x;
+		s.y = y;
+		w->storeState(s);
+		if (!(w->callbackEventTypes & EventType::WINDOW_POSITION))
+			return;
 		// if found, make it handle the event
 		EventPointer ewp = std::make_shared<EventWindowPosition>(wID, x, y);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ewp);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ewp);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::windowSizeCallback(GLFWwindow* glfwWindow, int width, int height) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Size event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
+		// keep the cached properties up to date, even if the event is not handled
+		Window::State s = w->getState();
+		s.width = width;
+		s.height = height;
+		w->storeState(s);
+		if (!(w->callbackEventTypes & EventType::WINDOW_SIZE))
+			return;
 		// if found, make it handle the event
 		EventPointer ews = std::make_shared<EventWindowSize>(wID, width, height);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ews);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ews);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::windowCloseCallback(GLFWwindow* glfwWindow) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Close event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer ewc = std::make_shared<EventWindowClose>(wID);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ewc);
-			w->doneCurrentContext();
-			// do not update the window, as any handled here may have deallocated any resources
-		}
+		w->makeContextCurrent();
+		w->handleEvent(ewc);
+		w->doneCurrentContext();
+		// do not update the window, as any handled here may have deallocated any resources
 	}
 
 	void WindowManager::windowRefreshCallback(GLFWwindow* glfwWindow) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Refresh event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer ewr = std::make_shared<EventWindowRefresh>(wID);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ewr);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ewr);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::windowFocusCallback(GLFWwindow* glfwWindow, int hasFocus) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Focus event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
+		// keep the cached properties up to date, even if the event is not handled
+		Window::State s = w->getState();
+		s.focused = hasFocus == GL_TRUE;
+		w->storeState(s);
+		if (!(w->callbackEventTypes & EventType::WINDOW_FOCUS))
+			return;
 		// if found, make it handle the event
 		EventPointer ewf = std::make_shared<EventWindowFocus>(wID, hasFocus == GL_TRUE);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ewf);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ewf);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::windowMaximizeCallback(GLFWwindow* glfwWindow, int toMaximize) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Maximize event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
+		// keep the cached properties up to date, even if the event is not handled
+		Window::State s = w->getState();
+		s.maximized = toMaximize == GL_TRUE;
+		w->storeState(s);
+		if (!(w->callbackEventTypes & EventType::WINDOW_MAXIMIZE))
+			return;
 		// if found, make it handle the event
 		EventPointer ewi = std::make_shared<EventWindowMaximize>(wID, toMaximize == GL_TRUE);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ewi);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ewi);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::windowIconifyCallback(GLFWwindow* glfwWindow, int toIconify) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Iconify event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
+		// keep the cached properties up to date, even if the event is not handled
+		Window::State s = w->getState();
+		s.iconified = toIconify == GL_TRUE;
+		w->storeState(s);
+		if (!(w->callbackEventTypes & EventType::WINDOW_ICONIFY))
+			return;
 		// if found, make it handle the event
 		EventPointer ewi = std::make_shared<EventWindowIconify>(wID, toIconify == GL_TRUE);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ewi);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ewi);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::windowFramebufferSizeCallback(GLFWwindow* glfwWindow, int width, int height) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Framebugger size event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
+		// keep the cached properties up to date, even if the event is not handled
+		Window::State s = w->getState();
+		s.framebufferWidth = width;
+		s.framebufferHeight = height;
+		w->storeState(s);
+		if (!(w->callbackEventTypes & EventType::FRAMEBUFFERSIZE))
+			return;
 		// if found, make it handle the event
 		EventPointer efs = std::make_shared<EventFrameBufferSize>(wID, width, height);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(efs);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(efs);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::windowContentScaleCallback(GLFWwindow* glfwWindow, float xScale, float yScale) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Content scale event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
+		// keep the cached properties up to date, even if the event is not handled
+		Window::State s = w->getState();
+		s.xScale = xScale;
+		s.yScale = yScale;
+		w->storeState(s);
+		if (!(w->callbackEventTypes & EventType::CONTENTSCALE))
+			return;
 		// if found, make it handle the event
 		EventPointer ecs = std::make_shared<EventContentScale>(wID, xScale, yScale);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ecs);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ecs);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputMouseButtonCallback(GLFWwindow* glfwWindow, int button, int action, int mods) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Mouse button event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer emb = std::make_shared<EventMouseButton>(
 		    wID, static_cast<MouseButtonType>(button), static_cast<ActionType>(action), mods);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(emb);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(emb);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputCursorPostionCallback(GLFWwindow* glfwWindow, double x, double y) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Cursor position event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer ecp = std::make_shared<EventCursorPosition>(wID, x, y);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ecp);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ecp);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputCursorEnterCallback(GLFWwindow* glfwWindow, int enter) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Cursor enter event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer ece = std::make_shared<EventCursorEnter>(wID, enter == GL_TRUE);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ece);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ece);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputScrollCallback(GLFWwindow* glfwWindow, double xOffset, double yOffset) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Scroll event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer es = std::make_shared<EventScroll>(wID, xOffset, yOffset);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(es);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(es);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputKeyCallback(GLFWwindow* glfwWindow, int key, int scancode, int action, int mods) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Input key event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer ek = std::make_shared<EventKey>(
 		    wID, static_cast<KeyType>(key), static_cast<char32_t>(scancode), static_cast<ActionType>(action), mods);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ek);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ek);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputCharCallback(GLFWwindow* glfwWindow, unsigned int codepoint) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Input char event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer ec = std::make_shared<EventChar>(wID, static_cast<char32_t>(codepoint));
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ec);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ec);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputCharModCallback(GLFWwindow* glfwWindow, unsigned int codepoint, int mods) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Input char mod event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		// if found, make it handle the event
 		EventPointer ecm = std::make_shared<EventCharMod>(wID, static_cast<char32_t>(codepoint), mods);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ecm);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ecm);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 	void WindowManager::inputDropCallback(GLFWwindow* glfwWindow, int count, const char** paths) {
 		// find the target Window
-		WindowID wID = Window::getWindowID(glfwWindow);
-		if (wID > LastWindowID) {
+		Window* w = Window::fromGLFWWindow(glfwWindow);
+		if (!w) {
 			std::cout << "Warning. Drop event received for unregistered Window. Discarded." << std::endl;
 			return;
 		}
+		const WindowID wID = w->getID();
 		if (count <= 0)
 			return;
 		// if found, make it handle the event
@@ -767,25 +1293,22 @@ namespace glfwm {
 		for (int i = 0; i < count; ++i)
 			pathStrings.push_back(paths[i]);
 		EventPointer ed = std::make_shared<EventDrop>(wID, pathStrings);
-		WindowPointer w = Window::getWindow(wID);
-		if (w) {
-			w->makeContextCurrent();
-			w->handleEvent(ed);
-			w->doneCurrentContext();
-			// if this window is being rendered concurrently, update soon
-			WindowGroupID gID = WindowGroup::getWindowGroup(wID);
-#ifndef NO_MULTITHREADING
-			WindowGroupPointer g = WindowGroup::getGroup(gID);
-			if (g && g->isRunningConcurrently()) {
-				g->setWindowToUpdate(wID);
-				g->process();
-			} else { // otherwise update all together
-				UpdateMap::setToUpdate(gID, wID);
-			}
-#else
+		w->makeContextCurrent();
+		w->handleEvent(ed);
+		w->doneCurrentContext();
+		// if this window is being rendered concurrently, update soon
+		WindowGroupID gID = w->getGroupID();
+#ifndef NO_MULTITHREADING
+		WindowGroupPointer g = WindowGroup::getGroup(gID);
+		if (g && g->isRunningConcurrently()) {
+			g->setWindowToUpdate(wID);
+			g->process();
+		} else { // otherwise update all together
 			UpdateMap::setToUpdate(gID, wID);
-#endif
 		}
+#else
+		UpdateMap::setToUpdate(gID, wID);
+#endif
 	}
 
 }
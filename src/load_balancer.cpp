@@ -0,0 +1,347 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#include <GLFWM/load_balancer.hpp>
+#include <GLFWM/window_group.hpp>
+
+#ifndef NO_MULTITHREADING
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace glfwm {
+
+	namespace {
+		/**
+		 *  @brief  The weight of the last measure in the smoothed loads.
+		 */
+		const double smoothing = 0.5;
+
+		/**
+		 *  @brief  The maximum number of moves kept for inspection.
+		 */
+		const size_t maxDecisions = 256;
+
+		/**
+		 *  @brief  The Unit struct represents the Windows of a group sharing their contexts, which are moved together.
+		 */
+		struct Unit {
+			std::vector<WindowID> windowIDs;
+			double load;
+			Unit() : load(0.0) {}
+		};
+	}
+
+	/**
+	 *  @brief  Flag telling whether the balancing is active, read by the groups to measure their Windows.
+	 */
+	std::atomic<bool> LoadBalancer::enabled(false);
+
+	/**
+	 *  @brief  The IDs of the groups in the pool.
+	 */
+	std::vector<WindowGroupID> LoadBalancer::pool;
+
+	/**
+	 *  @brief  The time between two balancing steps, in seconds.
+	 */
+	double LoadBalancer::interval = 1.0;
+
+	/**
+	 *  @brief  The minimum difference of load between two groups for moving Windows.
+	 */
+	double LoadBalancer::threshold = 0.1;
+
+	/**
+	 *  @brief  The time of the last balancing step.
+	 */
+	std::chrono::steady_clock::time_point LoadBalancer::lastBalance;
+
+	/**
+	 *  @brief  The smoothed load of each Window, as a fraction of a CPU.
+	 */
+	std::unordered_map<WindowID, double> LoadBalancer::windowLoads;
+
+	/**
+	 *  @brief  The smoothed load of each group, as a fraction of a CPU.
+	 */
+	std::unordered_map<WindowGroupID, double> LoadBalancer::groupLoads;
+
+	/**
+	 *  @brief  The most recent moves.
+	 */
+	std::deque<LoadBalancer::Decision> LoadBalancer::decisions;
+
+	/**
+	 *  @brief  The ID of the pending delayed task executing the next balancing step.
+	 */
+	Executor::TimedTaskID LoadBalancer::timerID = 0;
+
+	/**
+	 *  @brief  The number of times the balancing has been enabled, used to identify the periodic tasks.
+	 */
+	size_t LoadBalancer::generation = 0;
+
+	/**
+	 *  @brief  The run of the Executor the pending balancing step has been submitted to, see Executor::getRunCount.
+	 */
+	std::atomic<size_t> LoadBalancer::executorRun(0);
+
+	/**
+	 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+	 */
+	std::mutex LoadBalancer::globalMutex;
+
+	/**
+	 *  @brief  The enable static method starts balancing the Windows among a pool of WindowGroups.
+	 *  @param groupIDs The IDs of the groups in the pool, which should run their loops concurrently.
+	 *  @param interval The time between two balancing steps, in seconds.
+	 */
+	void LoadBalancer::enable(const std::vector<WindowGroupID>& groupIDs, const double interval) {
+		disable();
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		pool = groupIDs;
+		LoadBalancer::interval = interval > 0.0 ? interval : 1.0;
+		lastBalance = std::chrono::steady_clock::now();
+		windowLoads.clear();
+		groupLoads.clear();
+		// discard what has been measured so far
+		for (auto gID : pool) {
+			WindowGroupPointer g = WindowGroup::getGroup(gID);
+			if (g) {
+				std::lock_guard<std::mutex> statisticsLock(g->statisticsMutex);
+				g->windowCPUTimes.clear();
+				g->cpuTime = 0.0;
+			}
+		}
+		enabled = true;
+		timerID = Executor::submitAt(lastBalance + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		                                               std::chrono::duration<double>(LoadBalancer::interval)),
+		                             std::bind(&LoadBalancer::timerTask, ++generation));
+		executorRun = Executor::getRunCount();
+	}
+
+	/**
+	 *  @brief  The disable static method stops balancing and synchronizes with the end of any step in progress.
+	 */
+	void LoadBalancer::disable() {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		if (!enabled)
+			return;
+		enabled = false;
+		Executor::cancel(timerID);
+	}
+
+	/**
+	 *  @brief  The isEnabled static method says if the balancing is active.
+	 *  @return true if active, false otherwise.
+	 *  @note   Stopping the Executor discards the balancing steps: enable must be called again afterwards.
+	 */
+	bool LoadBalancer::isEnabled() {
+		return enabled && Executor::isRunning() && executorRun == Executor::getRunCount();
+	}
+
+	/**
+	 *  @brief  The setThreshold static method changes the minimum difference of load between the most and the least
+	 * loaded groups for moving Windows.
+	 *  @param threshold The minimum difference, as a fraction of a CPU. The default is 0.1.
+	 */
+	void LoadBalancer::setThreshold(const double threshold) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		LoadBalancer::threshold = threshold;
+	}
+
+	/**
+	 *  @brief  The balance static method measures the load of the groups in the pool and moves Windows from the most
+	 * to the least loaded ones. It is called periodically while enabled, but it can also be called directly.
+	 */
+	void LoadBalancer::balance() {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		if (!enabled)
+			return;
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const double elapsed = std::chrono::duration<double>(now - lastBalance).count();
+		if (elapsed <= 0.0)
+			return;
+		lastBalance = now;
+
+		// measure the load of the groups and of their Windows, grouping the Windows sharing their contexts
+		std::unordered_map<WindowGroupID, WindowGroupPointer> groups;
+		std::unordered_map<WindowGroupID, std::unordered_map<size_t, Unit>> units;
+		std::unordered_map<size_t, std::unordered_set<WindowGroupID>> shareGroups;
+		std::unordered_map<WindowID, double> cpuTimes;
+		std::unordered_map<WindowID, double> loads;
+		double cpuTime;
+		for (auto gID : pool) {
+			WindowGroupPointer g = WindowGroup::getGroup(gID);
+			if (!g)
+				continue;
+			groups[gID] = g;
+			{
+				std::lock_guard<std::mutex> statisticsLock(g->statisticsMutex);
+				cpuTimes.swap(g->windowCPUTimes);
+				cpuTime = g->cpuTime;
+				g->windowCPUTimes.clear();
+				g->cpuTime = 0.0;
+			}
+			double& gLoad = groupLoads[gID];
+			gLoad = smoothing * cpuTime / elapsed + (1.0 - smoothing) * gLoad;
+			std::unordered_set<WindowID> wIDs;
+			{
+				std::lock_guard<std::mutex> groupLock(g->mutex);
+				wIDs = g->attachedWindows;
+			}
+			for (auto wID : wIDs) {
+				WindowPointer w = Window::getWindow(wID);
+				if (!w)
+					continue;
+				double& wLoad = loads[wID];
+				wLoad = smoothing * cpuTimes[wID] / elapsed + (1.0 - smoothing) * windowLoads[wID];
+				Unit& u = units[gID][w->getContextShareID()];
+				u.windowIDs.push_back(wID);
+				u.load += wLoad;
+				shareGroups[w->getContextShareID()].insert(gID);
+			}
+			cpuTimes.clear();
+		}
+		// forget the Windows no longer in the pool
+		windowLoads.swap(loads);
+		if (groups.size() < 2)
+			return;
+
+		// greedily move units from the most to the least loaded group, while it reduces the imbalance
+		for (size_t move = 0; move < groups.size(); ++move) {
+			WindowGroupID heaviest = groups.begin()->first;
+			WindowGroupID lightest = heaviest;
+			for (auto& g : groups) {
+				if (groupLoads[g.first] > groupLoads[heaviest])
+					heaviest = g.first;
+				if (groupLoads[g.first] < groupLoads[lightest])
+					lightest = g.first;
+			}
+			const double difference = groupLoads[heaviest] - groupLoads[lightest];
+			if (difference < threshold)
+				break;
+			// the best unit to move is the one whose load is the closest to half the difference
+			std::unordered_map<size_t, Unit>::iterator best = units[heaviest].end();
+			for (auto it = units[heaviest].begin(); it != units[heaviest].end(); ++it) {
+				// Windows sharing their contexts with Windows of other groups can not be moved
+				if (shareGroups[it->first].size() > 1 || it->second.load <= 0.0 || it->second.load >= difference)
+					continue;
+				if (best == units[heaviest].end()
+				    || std::abs(it->second.load - difference / 2.0) < std::abs(best->second.load - difference / 2.0))
+					best = it;
+			}
+			if (best == units[heaviest].end())
+				break;
+
+			Decision d;
+			d.time = now;
+			d.windowIDs = best->second.windowIDs;
+			d.fromGroupID = heaviest;
+			d.toGroupID = lightest;
+			d.load = best->second.load;
+			d.fromGroupLoad = groupLoads[heaviest];
+			d.toGroupLoad = groupLoads[lightest];
+			{
+				// the source group moves the Windows before its next frame, as their contexts may be current on its
+				// thread, see WindowGroup::moveWindows
+				std::lock_guard<std::mutex> groupLock(groups[heaviest]->mutex);
+				for (auto wID : d.windowIDs)
+					groups[heaviest]->windowsToMove.push_back(std::make_pair(wID, lightest));
+			}
+			// make the source group move the Windows soon, and forward their update to the destination group
+			for (auto wID : d.windowIDs)
+				UpdateMap::notify(heaviest, wID);
+
+			groupLoads[heaviest] -= d.load;
+			groupLoads[lightest] += d.load;
+			units[lightest][best->first] = best->second;
+			units[heaviest].erase(best);
+			decisions.push_back(std::move(d));
+			if (decisions.size() > maxDecisions)
+				decisions.pop_front();
+		}
+	}
+
+	/**
+	 *  @brief  The getDecisions static method returns the most recent moves, oldest first.
+	 *  @param decisions The list of moves.
+	 */
+	void LoadBalancer::getDecisions(std::deque<Decision>& decisions) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		decisions = LoadBalancer::decisions;
+	}
+
+	/**
+	 *  @brief  The getGroupLoads static method returns the last measured load of the groups in the pool.
+	 *  @param loads The map from the IDs of the groups to their loads, as fractions of a CPU.
+	 */
+	void LoadBalancer::getGroupLoads(std::unordered_map<WindowGroupID, double>& loads) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		loads = groupLoads;
+	}
+
+	/**
+	 *  @brief  The getThreadCPUTime static method returns the CPU time consumed so far by the calling thread.
+	 *  @return The CPU time, in seconds.
+	 *  @note   Where not supported, the wall-clock time is returned instead.
+	 */
+	double LoadBalancer::getThreadCPUTime() {
+#if defined(_WIN32)
+		FILETIME creation, exit, kernel, user;
+		if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+			ULARGE_INTEGER k, u;
+			k.LowPart = kernel.dwLowDateTime;
+			k.HighPart = kernel.dwHighDateTime;
+			u.LowPart = user.dwLowDateTime;
+			u.HighPart = user.dwHighDateTime;
+			// FILETIME counts 100 nanoseconds intervals
+			return (k.QuadPart + u.QuadPart) * 1e-7;
+		}
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+		timespec ts;
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+			return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 *  @brief  The timerTask static method is the delayed task executing the periodic balancing steps.
+	 *  @param taskGeneration The generation of the balancing the task belongs to.
+	 */
+	void LoadBalancer::timerTask(const size_t taskGeneration) {
+		balance();
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		// a task started before disable must not keep going after a later enable
+		if (enabled && taskGeneration == generation) {
+			timerID = Executor::submitAt(std::chrono::steady_clock::now()
+			                                 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			                                     std::chrono::duration<double>(interval)),
+			                             std::bind(&LoadBalancer::timerTask, taskGeneration));
+			executorRun = Executor::getRunCount();
+		}
+	}
+
+}
+#endif
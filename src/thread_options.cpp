@@ -0,0 +1,125 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#include <GLFWM/thread_options.hpp>
+
+#ifndef NO_MULTITHREADING
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace glfwm {
+
+	/**
+	 *  @brief  Default constructor: no name, no CPU affinity and normal priority.
+	 */
+	ThreadOptions::ThreadOptions() : priority(ThreadPriority::PRIORITY_NORMAL) {}
+
+	/**
+	 *  @brief  The applyToCurrentThread method sets the options to the calling thread, where supported by the
+	 * platform.
+	 *  @return true if all the options have been applied, false otherwise.
+	 *  @note   A warning is printed for every option that could not be applied.
+	 */
+	bool ThreadOptions::applyToCurrentThread() const {
+		bool applied = true;
+
+		// name: not supported on Windows, where it just helps debugging
+		if (!name.empty()) {
+#if defined(__linux__)
+			// Linux limits names to 16 characters, including the terminator
+			if (pthread_setname_np(pthread_self(), name.substr(0, 15).c_str()) != 0) {
+				std::cout << "Warning. Unable to set the name " << name << " to a thread." << std::endl;
+				applied = false;
+			}
+#elif defined(__APPLE__)
+			if (pthread_setname_np(name.c_str()) != 0) {
+				std::cout << "Warning. Unable to set the name " << name << " to a thread." << std::endl;
+				applied = false;
+			}
+#endif
+		}
+
+		// CPU affinity
+		if (!cpus.empty()) {
+#if defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (auto cpu : cpus)
+				if (cpu < CPU_SETSIZE)
+					CPU_SET(cpu, &set);
+			if (CPU_COUNT(&set) == 0 || pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+				std::cout << "Warning. Unable to set the CPU affinity of thread " << name << "." << std::endl;
+				applied = false;
+			}
+#elif defined(_WIN32)
+			DWORD_PTR mask = 0;
+			for (auto cpu : cpus)
+				if (cpu < sizeof(DWORD_PTR) * 8)
+					mask |= DWORD_PTR(1) << cpu;
+			if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+				std::cout << "Warning. Unable to set the CPU affinity of thread " << name << "." << std::endl;
+				applied = false;
+			}
+#else
+			std::cout << "Warning. CPU affinity is not supported on this platform." << std::endl;
+			applied = false;
+#endif
+		}
+
+		// scheduling priority
+		if (priority != ThreadPriority::PRIORITY_NORMAL) {
+			bool done = false;
+#if defined(__linux__)
+			if (priority == ThreadPriority::PRIORITY_REALTIME) {
+				sched_param param;
+				param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+				done = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+			} else {
+				// on Linux the nice level is a per-thread attribute
+				const int niceLevel = priority == ThreadPriority::PRIORITY_LOW ? 10 : -10;
+				done = setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), niceLevel) == 0;
+			}
+#elif defined(__APPLE__)
+			// macOS schedules threads by quality of service classes
+			const qos_class_t qos = priority == ThreadPriority::PRIORITY_LOW ? QOS_CLASS_UTILITY
+			                                                                 : QOS_CLASS_USER_INTERACTIVE;
+			done = pthread_set_qos_class_self_np(qos, 0) == 0;
+#elif defined(_WIN32)
+			int p = THREAD_PRIORITY_TIME_CRITICAL;
+			if (priority == ThreadPriority::PRIORITY_LOW)
+				p = THREAD_PRIORITY_BELOW_NORMAL;
+			else if (priority == ThreadPriority::PRIORITY_HIGH)
+				p = THREAD_PRIORITY_ABOVE_NORMAL;
+			done = SetThreadPriority(GetCurrentThread(), p) != 0;
+#endif
+			if (!done) {
+				std::cout << "Warning. Unable to set the scheduling priority of thread " << name << "." << std::endl;
+				applied = false;
+			}
+		}
+
+		return applied;
+	}
+
+}
+#endif
@@ -12,13 +12,14 @@
 // email: marcias.giorgio@gmail.com
 
 #include <GLFWM/update_map.hpp>
+#include <GLFWM/window.hpp>
 
 namespace glfwm {
 
 	std::unordered_map<WindowGroupID, std::unordered_set<WindowID>> UpdateMap::groups_windows;
 
 #ifndef NO_MULTITHREADING
-	std::mutex UpdateMap::globalMutex;
+	ElidableMutex<std::mutex> UpdateMap::globalMutex;
 #endif
 
 	/**
@@ -34,6 +35,27 @@ namespace glfwm {
 		glfwPostEmptyEvent();
 	}
 
+	/**
+	 *  @brief  The notifyTag static method is used to wake up the WindowManager once and send a signal to all the
+	 * Windows labelled with a tag to update themselves.
+	 *  @param tag The tag of the Windows to update, see Window::addTag.
+	 */
+	void UpdateMap::notifyTag(const std::string& tag) {
+		std::unordered_set<WindowID> wIDs;
+		Window::getTaggedWindowIDs(tag, wIDs);
+		if (wIDs.empty())
+			return;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<ElidableMutex<std::mutex>> lock(globalMutex);
+#endif
+			std::unordered_set<WindowID>& toUpdate = groups_windows[AnyWindowGroupID];
+			toUpdate.insert(wIDs.begin(), wIDs.end());
+		}
+		glfwPostEmptyEvent();
+	}
+
 	/**
 	 *  @brief  The setToUpdate static method is used to collect a Window or WindowGroup target to update itself.
 	 *  @param gID The ID of the WindowGroup to update. It is ignored unless wID is WholeGroupWindowIDs or AllWindowIDs,
@@ -44,7 +66,7 @@ namespace glfwm {
 	void UpdateMap::setToUpdate(const WindowGroupID gID, const WindowID wID) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::mutex> lock(globalMutex);
+		std::lock_guard<ElidableMutex<std::mutex>> lock(globalMutex);
 #endif
 		groups_windows[gID].insert(wID);
 	}
@@ -57,7 +79,7 @@ namespace glfwm {
 	void UpdateMap::popGroup(WindowGroupID& gID, std::unordered_set<WindowID>& wIDs) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::mutex> lock(globalMutex);
+		std::lock_guard<ElidableMutex<std::mutex>> lock(globalMutex);
 #endif
 		gID = NoWindowGroupID;
 		wIDs.clear();
@@ -88,7 +110,7 @@ namespace glfwm {
 	bool UpdateMap::empty() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::mutex> lock(globalMutex);
+		std::lock_guard<ElidableMutex<std::mutex>> lock(globalMutex);
 #endif
 		return groups_windows.empty();
 	}
@@ -0,0 +1,286 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#include <GLFWM/concurrency.hpp>
+#include <GLFWM/watchdog.hpp>
+#include <GLFWM/window_group.hpp>
+
+#ifndef NO_MULTITHREADING
+namespace glfwm {
+
+	namespace {
+		/**
+		 *  @brief  The maximum number of stalls kept for inspection.
+		 */
+		const size_t maxStalls = 256;
+	}
+
+	/**
+	 *  @brief  Flag telling whether the watchdog thread is running, read by the loops to beat their heartbeats.
+	 */
+	std::atomic<bool> Watchdog::running(false);
+
+	/**
+	 *  @brief  The time a loop may be blocked before being reported, in seconds.
+	 */
+	double Watchdog::threshold = 1.0;
+
+	/**
+	 *  @brief  The function called for each stall.
+	 */
+	Watchdog::Callback Watchdog::callback;
+
+	/**
+	 *  @brief  The heartbeats of the loops, by group ID (NoWindowGroupID for the main loop).
+	 */
+	std::unordered_map<WindowGroupID, std::shared_ptr<Watchdog::Heartbeat>> Watchdog::heartbeats;
+
+	/**
+	 *  @brief  The most recent stalls.
+	 */
+	std::deque<Watchdog::Stall> Watchdog::stalls;
+
+	/**
+	 *  @brief  The watchdog thread.
+	 */
+	std::thread Watchdog::thread;
+
+	/**
+	 *  @brief  Condition variable used to wake up the watchdog thread when stopping.
+	 */
+	std::condition_variable Watchdog::conditionVariable;
+
+	/**
+	 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+	 */
+	std::mutex Watchdog::globalMutex;
+
+	/**
+	 *  @brief  The loop whose heartbeat the current thread beats, or AnyWindowGroupID if none.
+	 */
+	thread_local WindowGroupID Watchdog::currentLoop = AnyWindowGroupID;
+
+	/**
+	 *  @brief  The heartbeat of currentLoop, looked up at the first activity.
+	 */
+	thread_local std::shared_ptr<Watchdog::Heartbeat> Watchdog::currentHeartbeat;
+
+	/**
+	 *  @brief  Constructor for drawing.
+	 *  @param windowID The ID of the Window being drawn.
+	 *  @param drawable The Drawable drawing.
+	 */
+	Watchdog::Activity::Activity(const WindowID windowID, const DrawablePointer& drawable)
+	    : heartbeat(running ? beginActivity(windowID, &drawable, nullptr) : nullptr) {}
+
+	/**
+	 *  @brief  Constructor for handling events.
+	 *  @param windowID The ID of the Window handling an event.
+	 *  @param handler  The EventHandler handling the event.
+	 */
+	Watchdog::Activity::Activity(const WindowID windowID, const EventHandlerPointer& handler)
+	    : heartbeat(running ? beginActivity(windowID, nullptr, &handler) : nullptr) {}
+
+	/**
+	 *  @brief  Destructor, marks the calling thread as not busy.
+	 */
+	Watchdog::Activity::~Activity() {
+		if (heartbeat)
+			endActivity(*heartbeat);
+	}
+
+	/**
+	 *  @brief  The start static method starts the watchdog thread.
+	 *  @param threshold The time a loop may be blocked before being reported, in seconds.
+	 *  @param callback  The function called for each stall, from the watchdog thread. It may be empty.
+	 *  @note   The heartbeats are checked four times per threshold.
+	 */
+	void Watchdog::start(const double threshold, const Callback& callback) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		if (running)
+			return;
+		Watchdog::threshold = std::max(threshold, 0.001);
+		Watchdog::callback = callback;
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		for (auto& hb : heartbeats) {
+			// acquire ownership
+			std::lock_guard<std::mutex> lockHeartbeat(hb.second->mutex);
+			hb.second->lastBeats = hb.second->beats;
+			hb.second->lastChange = now;
+			hb.second->reported = false;
+		}
+		running = true;
+		// the callback may use the library
+		Concurrency::enable();
+		thread = std::thread(&Watchdog::watchdogLoop);
+	}
+
+	/**
+	 *  @brief  The stop static method stops the watchdog thread and synchronizes with its ending.
+	 *  @note   It must not be called from the callback.
+	 */
+	void Watchdog::stop() {
+		{
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(globalMutex);
+			running = false;
+		}
+		conditionVariable.notify_all();
+		if (thread.joinable())
+			thread.join();
+	}
+
+	/**
+	 *  @brief  The isRunning static method says if the watchdog thread is running.
+	 *  @return true if running, false otherwise.
+	 */
+	bool Watchdog::isRunning() { return running; }
+
+	/**
+	 *  @brief  The getStalls static method returns the most recent stalls, oldest first.
+	 *  @param stalls The list of stalls.
+	 */
+	void Watchdog::getStalls(std::deque<Stall>& stalls) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(globalMutex);
+		stalls = Watchdog::stalls;
+	}
+
+	/**
+	 *  @brief  The setCurrentLoop static method sets the loop whose heartbeat the calling thread beats.
+	 *  @param id The ID of the group, or NoWindowGroupID for the main loop.
+	 *  @return The ID of the loop previously set, or AnyWindowGroupID if none.
+	 */
+	WindowGroupID Watchdog::setCurrentLoop(const WindowGroupID id) {
+		const WindowGroupID previous = currentLoop;
+		if (id != currentLoop) {
+			currentLoop = id;
+			currentHeartbeat.reset();
+		}
+		return previous;
+	}
+
+	/**
+	 *  @brief  The beginActivity static method marks the calling thread as busy.
+	 *  @param windowID The ID of the Window.
+	 *  @param drawable The Drawable, or null.
+	 *  @param handler  The EventHandler, or null.
+	 *  @return The heartbeat of the loop of the calling thread, or null if the activity is not monitored.
+	 */
+	std::shared_ptr<Watchdog::Heartbeat> Watchdog::beginActivity(const WindowID windowID,
+	                             const DrawablePointer* drawable,
+	                             const EventHandlerPointer* handler) {
+		if (currentLoop == AnyWindowGroupID)
+			return nullptr;
+		if (!currentHeartbeat) {
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(globalMutex);
+			std::shared_ptr<Heartbeat>& hb = heartbeats[currentLoop];
+			if (!hb) {
+				hb = std::make_shared<Heartbeat>();
+				hb->lastChange = std::chrono::steady_clock::now();
+			}
+			currentHeartbeat = hb;
+		}
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(currentHeartbeat->mutex);
+		// a nested activity (e.g. an event handled while drawing) keeps the outer one
+		if (currentHeartbeat->busy)
+			return nullptr;
+		++currentHeartbeat->beats;
+		currentHeartbeat->busy = true;
+		currentHeartbeat->windowID = windowID;
+		currentHeartbeat->drawable = drawable;
+		currentHeartbeat->handler = handler;
+		return currentHeartbeat;
+	}
+
+	/**
+	 *  @brief  The endActivity static method marks the loop of an activity as not busy.
+	 *  @param heartbeat The heartbeat returned by beginActivity.
+	 */
+	void Watchdog::endActivity(Heartbeat& heartbeat) {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(heartbeat.mutex);
+		++heartbeat.beats;
+		heartbeat.busy = false;
+		heartbeat.drawable = nullptr;
+		heartbeat.handler = nullptr;
+	}
+
+	/**
+	 *  @brief  The watchdogLoop static method is the function executed by the watchdog thread.
+	 */
+	void Watchdog::watchdogLoop() {
+		ThreadOptions options;
+		options.name = "glfwm-watchdog";
+		options.applyToCurrentThread();
+		std::vector<Stall> detected;
+		std::unique_lock<std::mutex> lock(globalMutex);
+		while (running) {
+			conditionVariable.wait_for(lock, std::chrono::duration<double>(threshold / 4.0));
+			if (!running)
+				break;
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			detected.clear();
+			for (auto& hb : heartbeats) {
+				Heartbeat& h = *hb.second;
+				// acquire ownership
+				std::lock_guard<std::mutex> lockHeartbeat(h.mutex);
+				if (h.beats != h.lastBeats) {
+					h.lastBeats = h.beats;
+					h.lastChange = now;
+					h.reported = false;
+					continue;
+				}
+				const double duration = std::chrono::duration<double>(now - h.lastChange).count();
+				if (h.busy && !h.reported && duration >= threshold) {
+					h.reported = true;
+					Stall s;
+					s.time = now;
+					s.groupID = hb.first;
+					s.windowID = h.windowID;
+					// copied only when reporting, so activities do not touch the reference counts
+					if (h.drawable)
+						s.drawable = *h.drawable;
+					if (h.handler)
+						s.handler = *h.handler;
+					s.duration = duration;
+					detected.push_back(s);
+				}
+			}
+			if (detected.empty())
+				continue;
+			for (auto& s : detected) {
+				stalls.push_back(s);
+				if (stalls.size() > maxStalls)
+					stalls.pop_front();
+			}
+			const Callback cb = callback;
+			// report without holding the lock: the callback may use the Watchdog
+			lock.unlock();
+			for (auto& s : detected) {
+				WindowGroupPointer g = WindowGroup::getGroup(s.groupID);
+				if (g)
+					g->recordStall();
+				if (cb)
+					cb(s);
+			}
+			lock.lock();
+		}
+		Concurrency::disable();
+	}
+
+}
+#endif
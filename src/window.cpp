@@ -12,6 +12,7 @@
 // email: marcias.giorgio@gmail.com
 
 #include <GLFWM/window.hpp>
+#include <GLFWM/window_group.hpp>
 
 namespace glfwm {
 
@@ -23,6 +24,8 @@ namespace glfwm {
 	 *  @param  title The title of the window.
 	 *  @param  monitor The GLFWMonitor to associate this window to in case of fullscreen. Use nullptr otherwise.
 	 *  @param  share Another Window to share the context with. Use nullptr for a non-shared context.
+	 *  @param  poolHints The hints set for creating the window, on top of the default ones, for recycling GLFW windows
+	 * (see WindowPool). Use nullptr if not known, and the window is neither recycled nor kept.
 	 *  @note   The creation of a GLFW window may occur only in the main thread. Do not instantiate a Window in
 	 * secondary threads.
 	 */
@@ -31,21 +34,57 @@ namespace glfwm {
 	               const int height,
 	               const std::string& title,
 	               GLFWmonitor* monitor,
-	               const WindowPointer& share)
-	    : windowID(id)
+	               const WindowPointer& share,
+	               const WindowPool::Hints* poolHints)
+	    : glfwWindow(nullptr),
+	      windowID(id),
+	      userPointer(nullptr),
+	      owningGroupID(NoWindowGroupID),
+	      callbackEventTypes(0),
+	      recyclable(poolHints && !monitor && !share),
+	      withContext(true),
+#ifdef VK_VERSION_1_0
+	      vulkanInstance(VK_NULL_HANDLE),
+	      vulkanAllocator(nullptr),
+	      vulkanSurface(VK_NULL_HANDLE),
+#endif
+	      appliedTitle(title),
+	      appliedOpacity(1.0f),
+	      preparingDrawables(0)
 #ifndef NO_MULTITHREADING
 	      ,
-	      sharedMutexID(share ? share->sharedMutexID : newMutexID())
+	      sharedMutexID(share ? shareMutexID(share->sharedMutexID) : newMutexID())
 #endif
 	{
-		glfwWindow = glfwCreateWindow(width, height, title.c_str(), monitor, share ? share->glfwWindow : nullptr);
-		if (!glfwWindow)
-			throw std::runtime_error(std::string("Error. GLFW window not created."));
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
-#endif
-		windowsMap.insert(std::make_pair(glfwWindow, id));
+		if (recyclable) {
+			poolKey = WindowPool::makeKey(*poolHints);
+			glfwWindow = WindowPool::acquire(poolKey);
+		}
+		if (glfwWindow) {
+			glfwSetWindowSize(glfwWindow, width, height);
+			glfwSetWindowTitle(glfwWindow, title.c_str());
+			// as if just created with the hints
+			bool visible = true;
+			bool maximized = false;
+			for (auto& h : *poolHints)
+				if (h.first == GLFW_VISIBLE)
+					visible = h.second != GL_FALSE;
+				else if (h.first == GLFW_MAXIMIZED)
+					maximized = h.second != GL_FALSE;
+			if (maximized)
+				glfwMaximizeWindow(glfwWindow);
+			if (visible)
+				glfwShowWindow(glfwWindow);
+		} else {
+			glfwWindow = glfwCreateWindow(width, height, title.c_str(), monitor, share ? share->glfwWindow : nullptr);
+			if (!glfwWindow)
+				throw std::runtime_error(std::string("Error. GLFW window not created."));
+		}
+		// windows created for Vulkan, or presented by other means, never switch context
+		withContext = glfwGetWindowAttrib(glfwWindow, GLFW_CLIENT_API) != GLFW_NO_API;
+		// route the callbacks to this Window without any lookup
+		glfwSetWindowUserPointer(glfwWindow, this);
+		refreshState();
 	}
 
 	/**
@@ -62,17 +101,36 @@ namespace glfwm {
 		if (sharedMutexID >= mutexes.size())
 			return; // probably this Window has been already destroied at this moment
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow) {
-			unmapWindow(glfwWindow);
-			glfwDestroyWindow(glfwWindow);
+			glfwSetWindowUserPointer(glfwWindow, nullptr);
+			removeAllTags();
+#ifdef VK_VERSION_1_0
+			// the surface must not outlive its window
+			destroyVulkanSurface();
+#endif
+#ifndef NO_MULTITHREADING
+			// a context other Windows share with would be recycled with their mutex
+			if (recyclable) {
+				// acquire shared ownership
+				SharedLockGuard<ElidableShardedMutex> lockGlobal(globalMutex);
+				recyclable = mutexes[sharedMutexID].count == 1;
+			}
+#endif
+			// both release the context, if current on this thread
+			if (currentContextID == windowID)
+				currentContextID = AllWindowIDs;
+			if (!recyclable || !WindowPool::release(glfwWindow, poolKey))
+				glfwDestroyWindow(glfwWindow);
 			glfwWindow = nullptr;
-			freeWindowID(windowID);
+			storeState(State());
 #ifndef NO_MULTITHREADING
 			decreaseMutexCount(sharedMutexID);
 			sharedMutexID = std::numeric_limits<MutexID>::max();
 #endif
+			// last, as it may release the last reference to this Window
+			freeWindowID(windowID);
 		}
 	}
 
@@ -82,6 +140,12 @@ namespace glfwm {
 	 */
 	WindowID Window::getID() const { return windowID; }
 
+	/**
+	 *  @brief  The getGroupID method returns the ID of the WindowGroup this Window is attached to, without locking.
+	 *  @return The ID of the group, or NoWindowGroupID.
+	 */
+	WindowGroupID Window::getGroupID() const { return owningGroupID; }
+
 	/**
 	 *  @brief  The bindEventHandler method binds an EventHandler by adding it to the list of handlers in a position
 	 * determined by the rank r.
@@ -92,7 +156,7 @@ namespace glfwm {
 	void Window::bindEventHandler(const EventHandlerPointer& eh, const RankType r) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 
 		EventHandlersIterator position;
@@ -125,7 +189,7 @@ namespace glfwm {
 	void Window::unbindEventHandler(const EventHandlerPointer& eh) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 
 		// first, look up the handler among those already bound
@@ -148,7 +212,7 @@ namespace glfwm {
 	void Window::handleEvent(const EventPointer& e) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 
 		// check if this is the right recipient
@@ -157,8 +221,14 @@ namespace glfwm {
 
 		// search the first handler that handles event e
 		for (auto& h : eventHandlers)
-			if (h.object->getHandledEventTypes() & e->getEventType() && h.object->handle(e))
-				return;
+			if (h.object->getHandledEventTypes() & e->getEventType()) {
+#ifndef NO_MULTITHREADING
+				// let the watchdog know who is blocking, if the handler does not return
+				Watchdog::Activity activity(windowID, h.object);
+#endif
+				if (h.object->handle(e))
+					return;
+			}
 	}
 
 	/**
@@ -172,7 +242,7 @@ namespace glfwm {
 	void Window::bindDrawable(const DrawablePointer& d, const RankType r) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 
 		DrawablesIterator position;
@@ -188,6 +258,8 @@ namespace glfwm {
 			using DrawableMapInserResult = std::pair<DrawableMapIterator, bool>;
 			DrawableMapInserResult res = drawableMap.insert(std::make_pair(d, drawables.end()));
 			dIt = res.first;
+			if (d->hasPrepare())
+				++preparingDrawables;
 		}
 
 		// then (re)bind it
@@ -205,7 +277,7 @@ namespace glfwm {
 	void Window::unbindDrawable(const DrawablePointer& d) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 
 		// first, look up the drawable among those already bound
@@ -217,6 +289,8 @@ namespace glfwm {
 			drawables.erase(dIt->second);
 			// remove it from the map
 			drawableMap.erase(dIt);
+			if (d->hasPrepare())
+				--preparingDrawables;
 		}
 	}
 
@@ -227,11 +301,73 @@ namespace glfwm {
 	void Window::draw() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		// draw each drawable in sequence
-		for (auto& d : drawables)
+		for (auto& d : drawables) {
+#ifndef NO_MULTITHREADING
+			// let the watchdog know who is blocking, if the drawable does not return
+			Watchdog::Activity activity(windowID, d.object);
+#endif
 			d.object->draw(windowID);
+		}
+	}
+
+	/**
+	 *  @brief  The prepareWindows static method calls Drawable::prepare on the drawables of some Windows which
+	 * implement it, in rank order within each Window and in parallel, on the Executor, across the Windows.
+	 *  @param ids   The IDs of the Windows going to be drawn.
+	 *  @param frame The frame going to be drawn.
+	 *  @note   It returns when all the drawables have been prepared. If NO_MULTITHREADING is defined, the Windows are
+	 * prepared one after the other on the calling thread.
+	 */
+	void Window::prepareWindows(const std::vector<WindowID>& ids, const FrameInfo& frame) {
+		// collect the drawables first, so that only the Windows having some to prepare are dispatched
+		std::vector<std::pair<WindowID, DrawablePointer>>& toPrepare = drawablesToPrepare;
+		std::vector<size_t>& starts = prepareJobStarts;
+		toPrepare.clear();
+		starts.clear();
+		WindowRef w;
+		for (auto id : ids) {
+			w = borrowWindow(id);
+			// most Windows have nothing to prepare: skip them without locking
+			if (!w || w->preparingDrawables == 0)
+				continue;
+			const size_t start = toPrepare.size();
+			{
+#ifndef NO_MULTITHREADING
+				// acquire ownership
+				std::lock_guard<ElidableRecursiveMutex> lock(mutexes[w->sharedMutexID].mutex);
+#endif
+				for (auto& d : w->drawables)
+					if (d.object->hasPrepare())
+						toPrepare.push_back(std::make_pair(id, d.object));
+			}
+			if (toPrepare.size() > start)
+				starts.push_back(start);
+		}
+		if (starts.empty())
+			return;
+		starts.push_back(toPrepare.size());
+		// the drawables are prepared without the lock of their Window, as they do not use the context; the buffers of
+		// the calling thread are referred to by the workers
+		auto prepareJob = [&toPrepare, &starts, &frame](const size_t i) {
+			for (size_t j = starts[i]; j < starts[i + 1]; ++j) {
+#ifndef NO_MULTITHREADING
+				// let the watchdog know who is blocking, if the drawable does not return
+				Watchdog::Activity activity(toPrepare[j].first, toPrepare[j].second);
+#endif
+				toPrepare[j].second->prepare(toPrepare[j].first, frame);
+			}
+		};
+#ifndef NO_MULTITHREADING
+		Executor::parallelFor(starts.size() - 1, prepareJob);
+#else
+		for (size_t i = 0; i + 1 < starts.size(); ++i)
+			prepareJob(i);
+#endif
+		// release the drawables, keeping the capacity
+		toPrepare.clear();
 	}
 
 	/**
@@ -241,7 +377,7 @@ namespace glfwm {
 	bool Window::shouldClose() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return glfwWindowShouldClose(glfwWindow);
@@ -255,21 +391,29 @@ namespace glfwm {
 	void Window::setShouldClose(const bool c) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetWindowShouldClose(glfwWindow, c ? GL_TRUE : GL_FALSE);
 	}
 
 	/**
-	 *  @brief  The getTitle method returns the current title.
+	 *  @brief  The getTitle method returns the current title, or the one set and not applied yet.
 	 *  @note   This may only be called from the main thread.
 	 *  @return This window's current title.
 	 */
 	std::string Window::getTitle() const {
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(propertiesMutex);
+#endif
+			if (pendingProperties.flags & TitleProperty)
+				return pendingProperties.title;
+		}
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return glfwGetWindowTitle(glfwWindow);
@@ -279,75 +423,65 @@ namespace glfwm {
 	/**
 	 *  @brief  The setTitle method changes the current title.
 	 *  @param title The new window title.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   This may be called from any thread: the title is applied by the main loop, see
+	 * applyPendingProperties.
 	 */
 	void Window::setTitle(const std::string& title) {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwSetWindowTitle(glfwWindow, title.c_str());
+		PendingProperties p;
+		p.title = title;
+		writeProperties(TitleProperty, p);
 	}
 
 	/**
 	 *  @brief  The getPosition method returns the x and y screen coordinate position.
 	 *  @param x The x coordinate.
 	 *  @param y The y coordintate.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   This may be called from any thread without locking, see getState.
 	 */
 	void Window::getPosition(int& x, int& y) const {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwGetWindowPos(glfwWindow, &x, &y);
+		const State s = getState();
+		x = s.x;
+		y = s.y;
 	}
 
 	/**
 	 *  @brief  The getPosition method sets the x and y screen coordinate position.
 	 *  @param x The x coordinate.
 	 *  @param y The y coordintate.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   This may be called from any thread: the position is applied by the main loop, see
+	 * applyPendingProperties.
 	 */
 	void Window::setPosition(const int x, const int y) {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwSetWindowPos(glfwWindow, x, y);
+		PendingProperties p;
+		p.x = x;
+		p.y = y;
+		writeProperties(PositionProperty, p);
 	}
 
 	/**
 	 *  @brief  The getSize method returns the width and height of this window area.
 	 *  @param width The width of this window area.
 	 *  @param height The height of this window area.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   This may be called from any thread without locking, see getState.
 	 */
 	void Window::getSize(int& width, int& height) const {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwGetWindowSize(glfwWindow, &width, &height);
+		const State s = getState();
+		width = s.width;
+		height = s.height;
 	}
 
 	/**
 	 *  @brief  The setSize method sets the width and height of this window area.
 	 *  @param width The width of this window area.
 	 *  @param height The height of this window area.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   This may be called from any thread: the size is applied by the main loop, see
+	 * applyPendingProperties.
 	 */
 	void Window::setSize(const int width, const int height) {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwSetWindowSize(glfwWindow, width, height);
+		PendingProperties p;
+		p.width = width;
+		p.height = height;
+		writeProperties(SizeProperty, p);
 	}
 
 	/**
@@ -369,7 +503,7 @@ namespace glfwm {
 	void Window::setSizeLimits(const int minWidth, const int minHeight, const int maxWidth, const int maxHeight) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetWindowSizeLimits(glfwWindow, minWidth, minHeight, maxWidth, maxHeight);
@@ -393,7 +527,7 @@ namespace glfwm {
 	void Window::setAspectRatio(const int numerator, const int denominator) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetWindowAspectRatio(glfwWindow, numerator, denominator);
@@ -403,15 +537,12 @@ namespace glfwm {
 	 *  @brief  The getFramebufferSize method returns the width and height of this window framebuffer.
 	 *  @param width The width of this window framebuffer.
 	 *  @param height The height of this window framebuffer.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   This may be called from any thread without locking, see getState.
 	 */
 	void Window::getFramebufferSize(int& width, int& height) const {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwGetFramebufferSize(glfwWindow, &width, &height);
+		const State s = getState();
+		width = s.framebufferWidth;
+		height = s.framebufferHeight;
 	}
 
 	/**
@@ -425,7 +556,7 @@ namespace glfwm {
 	void Window::getFrameSize(int& left, int& top, int& right, int& bottom) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwGetWindowFrameSize(glfwWindow, &left, &top, &right, &bottom);
@@ -443,15 +574,12 @@ namespace glfwm {
 	 *  which monitor the system considers the window to be on.
 	 *  @param xScale The scale in x of this window content.
 	 *  @param yScale The scale in y of this window content.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   This may be called from any thread without locking, see getState.
 	 */
 	void Window::getContentScale(float& xScale, float& yScale) const {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwGetWindowContentScale(glfwWindow, &xScale, &yScale);
+		const State s = getState();
+		xScale = s.xScale;
+		yScale = s.yScale;
 	}
 
 	/**
@@ -467,7 +595,7 @@ namespace glfwm {
 	float Window::getOpacity() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return glfwGetWindowOpacity(glfwWindow);
@@ -483,15 +611,13 @@ namespace glfwm {
 	 * this are undefined.
 	 *
 	 * @param opacity The opacity to set to this window.
-	 * @note   This may only be called from the main thread.
+	 * @note   This may be called from any thread: the opacity is applied by the main loop, see
+	 * applyPendingProperties.
 	 */
 	void Window::setOpacity(float opacity) {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
-#endif
-		if (glfwWindow)
-			glfwSetWindowOpacity(glfwWindow, opacity);
+		PendingProperties p;
+		p.opacity = opacity;
+		writeProperties(OpacityProperty, p);
 	}
 
 	/**
@@ -508,7 +634,7 @@ namespace glfwm {
 	void Window::requestAttention() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwRequestWindowAttention(glfwWindow);
@@ -523,7 +649,7 @@ namespace glfwm {
 	InputModeValueType Window::getInputMode(const InputModeType inputMode) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return static_cast<InputModeValueType>(
@@ -543,7 +669,7 @@ namespace glfwm {
 	void Window::setInputMode(const InputModeType inputMode, const InputModeValueType inputModeValue) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetInputMode(glfwWindow,
@@ -560,7 +686,7 @@ namespace glfwm {
 	ActionType Window::getKey(const KeyType key) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return static_cast<ActionType>(glfwGetKey(glfwWindow, static_cast<KeyBaseType>(key)));
@@ -577,7 +703,7 @@ namespace glfwm {
 	ActionType Window::getMouseButton(const MouseButtonType mouseButton) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return static_cast<ActionType>(
@@ -594,7 +720,7 @@ namespace glfwm {
 	void Window::setCursor(GLFWcursor* cursor) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetCursor(glfwWindow, cursor);
@@ -609,7 +735,7 @@ namespace glfwm {
 	void Window::getCursorPosition(double& x, double& y) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwGetCursorPos(glfwWindow, &x, &y);
@@ -624,7 +750,7 @@ namespace glfwm {
 	void Window::setCursorPosition(double x, double y) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetCursorPos(glfwWindow, x, y);
@@ -647,7 +773,7 @@ namespace glfwm {
 	void Window::setIcon(const int count, const GLFWimage* images) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetWindowIcon(glfwWindow, count, images);
@@ -661,7 +787,7 @@ namespace glfwm {
 	void Window::maximize() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwMaximizeWindow(glfwWindow);
@@ -674,7 +800,7 @@ namespace glfwm {
 	void Window::iconify() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwIconifyWindow(glfwWindow);
@@ -687,7 +813,7 @@ namespace glfwm {
 	void Window::restore() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwRestoreWindow(glfwWindow);
@@ -700,7 +826,7 @@ namespace glfwm {
 	void Window::hide() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwHideWindow(glfwWindow);
@@ -713,7 +839,7 @@ namespace glfwm {
 	void Window::show() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwShowWindow(glfwWindow);
@@ -731,7 +857,7 @@ namespace glfwm {
 	void Window::focus() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwFocusWindow(glfwWindow);
@@ -744,7 +870,7 @@ namespace glfwm {
 	GLFWmonitor* Window::getMonitor() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return glfwGetWindowMonitor(glfwWindow);
@@ -779,7 +905,7 @@ namespace glfwm {
 	                        const int refreshRate) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetWindowMonitor(glfwWindow, monitor, xpos, ypos, width, height, refreshRate);
@@ -789,18 +915,148 @@ namespace glfwm {
 	 *  @brief  The getAttribute method returns this window attributes. See GLFW.
 	 *  @param  attribute The attribute to read.
 	 *  @return The value of attribute for this window.
-	 *  @note   This may only be called from the main thread.
+	 *  @note   GLFW_FOCUSED, GLFW_ICONIFIED and GLFW_MAXIMIZED may be read from any thread without locking, see
+	 * getState. The other attributes may only be read from the main thread.
 	 */
 	int Window::getAttribute(const int attribute) const {
+		switch (attribute) {
+			case GLFW_FOCUSED:
+				return getState().focused ? GL_TRUE : GL_FALSE;
+			case GLFW_ICONIFIED:
+				return getState().iconified ? GL_TRUE : GL_FALSE;
+			case GLFW_MAXIMIZED:
+				return getState().maximized ? GL_TRUE : GL_FALSE;
+			default:
+				break;
+		}
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return glfwGetWindowAttrib(glfwWindow, attribute);
 		return 0;
 	}
 
+	/**
+	 *  @brief  The getState method returns the position, sizes, content scale, focus, iconification and maximization
+	 * of this window all together.
+	 *  @return The properties last reported by GLFW.
+	 *  @note   This may be called from any thread without locking: the properties are cached and refreshed by the
+	 * callbacks, which WindowManager registers for each Window it creates.
+	 */
+	Window::State Window::getState() const {
+#ifndef NO_MULTITHREADING
+		return state.load();
+#else
+		return state;
+#endif
+	}
+
+	/**
+	 *  @brief  The storeState method sets the cached properties of this window.
+	 *  @param s The properties.
+	 *  @note   This may only be called from the main thread.
+	 */
+	void Window::storeState(const State& s) {
+#ifndef NO_MULTITHREADING
+		state.store(s);
+#else
+		state = s;
+#endif
+	}
+
+	/**
+	 *  @brief  The refreshState method reads all the cached properties of this window from GLFW.
+	 *  @note   This may only be called from the main thread.
+	 */
+	void Window::refreshState() {
+		State s;
+		glfwGetWindowPos(glfwWindow, &s.x, &s.y);
+		glfwGetWindowSize(glfwWindow, &s.width, &s.height);
+		glfwGetFramebufferSize(glfwWindow, &s.framebufferWidth, &s.framebufferHeight);
+		glfwGetWindowContentScale(glfwWindow, &s.xScale, &s.yScale);
+		s.focused = glfwGetWindowAttrib(glfwWindow, GLFW_FOCUSED) == GL_TRUE;
+		s.iconified = glfwGetWindowAttrib(glfwWindow, GLFW_ICONIFIED) == GL_TRUE;
+		s.maximized = glfwGetWindowAttrib(glfwWindow, GLFW_MAXIMIZED) == GL_TRUE;
+		storeState(s);
+	}
+
+	/**
+	 *  @brief  The writeProperties method records the properties written, queuing this window for the main loop.
+	 *  @param flag The property written.
+	 *  @param p    The values of the properties, of which only those in flag are read.
+	 */
+	void Window::writeProperties(const PropertyFlag flag, const PendingProperties& p) {
+		bool queue;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(propertiesMutex);
+#endif
+			// the window is queued once, however many writes happen before the main loop applies them
+			queue = pendingProperties.flags == 0;
+			pendingProperties.flags |= flag;
+			if (flag & TitleProperty)
+				pendingProperties.title = p.title;
+			if (flag & PositionProperty) {
+				pendingProperties.x = p.x;
+				pendingProperties.y = p.y;
+			}
+			if (flag & SizeProperty) {
+				pendingProperties.width = p.width;
+				pendingProperties.height = p.height;
+			}
+			if (flag & OpacityProperty)
+				pendingProperties.opacity = p.opacity;
+		}
+		if (!queue)
+			return;
+		bool wakeUp;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(propertiesGlobalMutex);
+#endif
+			wakeUp = windowsWithPendingProperties.empty();
+			windowsWithPendingProperties.push_back(windowID);
+		}
+		// let the main loop apply them, even if waiting for events
+		if (wakeUp)
+			glfwPostEmptyEvent();
+	}
+
+	/**
+	 *  @brief  The applyProperties method applies the pending properties of this window.
+	 *  @note   This may only be called from the main thread.
+	 */
+	void Window::applyProperties() {
+		PendingProperties p;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(propertiesMutex);
+#endif
+			std::swap(p, pendingProperties);
+		}
+		// glfwWindow is destroyed only in the main thread, so the context need not be locked
+		if (!glfwWindow)
+			return;
+		const State s = getState();
+		if ((p.flags & TitleProperty) && p.title != appliedTitle) {
+			glfwSetWindowTitle(glfwWindow, p.title.c_str());
+			appliedTitle = p.title;
+		}
+		if ((p.flags & PositionProperty) && (p.x != s.x || p.y != s.y))
+			glfwSetWindowPos(glfwWindow, p.x, p.y);
+		if ((p.flags & SizeProperty) && (p.width != s.width || p.height != s.height))
+			glfwSetWindowSize(glfwWindow, p.width, p.height);
+		if ((p.flags & OpacityProperty) && p.opacity != appliedOpacity) {
+			glfwSetWindowOpacity(glfwWindow, p.opacity);
+			appliedOpacity = p.opacity;
+		}
+	}
+
 	/**
 	 *  @brief  The setAttribute method sets this window `attribute` to the specified `value`. See GLFW.
 	 *  @param  attribute The attribute to write.
@@ -810,7 +1066,7 @@ namespace glfwm {
 	void Window::setAttribute(const int attribute, const int value) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			return glfwSetWindowAttrib(glfwWindow, attribute, value);
@@ -823,11 +1079,9 @@ namespace glfwm {
 	void* Window::getUserPointer() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
-		if (glfwWindow)
-			return glfwGetWindowUserPointer(glfwWindow);
-		return nullptr;
+		return userPointer;
 	}
 
 	/**
@@ -837,10 +1091,9 @@ namespace glfwm {
 	void Window::setUserPointer(void* pointer) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
-		if (glfwWindow)
-			glfwSetWindowUserPointer(glfwWindow, pointer);
+		userPointer = pointer;
 	}
 
 	/**
@@ -851,7 +1104,7 @@ namespace glfwm {
 	void Window::getClipboardString(std::string& text) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		text.clear();
 		if (glfwWindow) {
@@ -869,47 +1122,208 @@ namespace glfwm {
 	void Window::setClipboardString(const std::string& text) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSetClipboardString(glfwWindow, text.c_str());
 	}
 
 	/**
-	 *  @brief  The swapBuffers method swaps the front and the back buffer.
+	 *  @brief  The swapBuffers method swaps the front and the back buffer. It does nothing if this Window has no
+	 * context, see hasContext.
 	 */
 	void Window::swapBuffers() {
+		if (!withContext)
+			return;
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (glfwWindow)
 			glfwSwapBuffers(glfwWindow);
 	}
 
 	/**
-	 *  @brief  The makeContextCurrent method makes the context associated to this window current.
+	 *  @brief  The makeContextCurrent method makes the context associated to this window current, unless it is
+	 * already current on the calling thread. If this Window has no context (see hasContext), it only locks the
+	 * Window.
+	 *  @note   The context current on each thread is tracked by this method, releaseCurrentContext and
+	 * doneCurrentContext: switch contexts directly with GLFW only after releaseCurrentContext.
 	 */
 	void Window::makeContextCurrent() {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		mutexes[sharedMutexID].mutex.lock();
+		MutexData& m = mutexes[sharedMutexID];
+		// acquire ownership, recording the waits for another group if requested
+		if (!ContentionDetector::isEnabled()) {
+			m.mutex.lock();
+		} else if (!m.mutex.try_lock()) {
+			const WindowGroupID owner = m.ownerGroupID;
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			m.mutex.lock();
+			ContentionDetector::recordWait(
+			    sharedMutexID,
+			    owner,
+			    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+		m.ownerGroupID.store(ContentionDetector::getCurrentGroup(), std::memory_order_relaxed);
+#endif
+		if (!glfwWindow || !withContext)
+			return;
+		if (currentContextID == windowID) {
+#ifndef NO_MULTITHREADING
+			avoidedContextSwitches.fetch_add(1, std::memory_order_relaxed);
+#else
+			++avoidedContextSwitches;
+#endif
+			return;
+		}
+		glfwMakeContextCurrent(glfwWindow);
+		currentContextID = windowID;
+#ifndef NO_MULTITHREADING
+		contextSwitches.fetch_add(1, std::memory_order_relaxed);
+#else
+		++contextSwitches;
 #endif
-		if (glfwWindow)
-			glfwMakeContextCurrent(glfwWindow);
 	}
 
 	/**
 	 *  @brief  The doneCurrentContext method releases the resources held by makeContextCurrent.
+	 *  @param keepCurrent true for keeping the context current on the calling thread, so that the next
+	 * makeContextCurrent on this window is free, false for releasing it, e.g. before another thread uses it.
 	 *  @note   A call to this may only follow a call to makeContextCurrent, without nesting, otherwise the behaviour is
-	 * undefined. This method does nothing if NO_MULTITHREADING is defined.
+	 * undefined. If NO_MULTITHREADING is defined, this method only releases the context, if requested.
 	 */
-	void Window::doneCurrentContext() {
+	void Window::doneCurrentContext(const bool keepCurrent) {
+		if (!keepCurrent && currentContextID == windowID)
+			releaseCurrentContext();
 #ifndef NO_MULTITHREADING
 		mutexes[sharedMutexID].mutex.unlock();
 #endif
 	}
 
+	/**
+	 *  @brief  The releaseCurrentContext static method makes no context current on the calling thread, if one has been
+	 * made current by makeContextCurrent.
+	 */
+	void Window::releaseCurrentContext() {
+		if (currentContextID == AllWindowIDs)
+			return;
+		glfwMakeContextCurrent(nullptr);
+		currentContextID = AllWindowIDs;
+	}
+
+	/**
+	 *  @brief  The getContextSwitchCounts static method returns how many times makeContextCurrent has switched context,
+	 * and how many times it has not as the context was already current, in all threads.
+	 *  @param switches The number of switches made.
+	 *  @param avoided  The number of switches avoided.
+	 */
+	void Window::getContextSwitchCounts(unsigned long long& switches, unsigned long long& avoided) {
+		switches = contextSwitches;
+		avoided = avoidedContextSwitches;
+	}
+
+	/**
+	 *  @brief  The resetContextSwitchCounts static method sets the counts of getContextSwitchCounts to zero.
+	 */
+	void Window::resetContextSwitchCounts() {
+		contextSwitches = 0;
+		avoidedContextSwitches = 0;
+	}
+
+#ifndef NO_MULTITHREADING
+	/**
+	 *  @brief  The getContextShareID method returns an ID shared by all the Windows whose contexts share objects with
+	 * this Window's one.
+	 *  @return The ID of the share group of this Window's context.
+	 */
+	size_t Window::getContextShareID() const { return sharedMutexID; }
+#endif
+
+	/**
+	 *  @brief  The hasContext method says if this Window has an OpenGL or OpenGL ES context, i.e. if it has not been
+	 * created with the GLFW_CLIENT_API hint set to GLFW_NO_API, as for Vulkan.
+	 *  @return true if this Window has a context, false otherwise.
+	 */
+	bool Window::hasContext() const { return withContext; }
+
+	/**
+	 *  @brief  The addTag method labels this Window with a tag, so that it can be addressed together with the other
+	 * Windows with the same tag (e.g. see UpdateMap::notifyTag).
+	 *  @param tag The tag.
+	 */
+	void Window::addTag(const std::string& tag) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		if (tags.insert(tag).second)
+			taggedWindows[tag].insert(windowID);
+	}
+
+	/**
+	 *  @brief  The removeTag method removes a tag from this Window.
+	 *  @param tag The tag.
+	 */
+	void Window::removeTag(const std::string& tag) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		if (tags.erase(tag) == 0)
+			return;
+		std::unordered_map<std::string, std::unordered_set<WindowID>>::iterator it = taggedWindows.find(tag);
+		if (it != taggedWindows.end()) {
+			it->second.erase(windowID);
+			if (it->second.empty())
+				taggedWindows.erase(it);
+		}
+	}
+
+	/**
+	 *  @brief  The hasTag method says if this Window is labelled with a tag.
+	 *  @param tag The tag.
+	 *  @return true if this Window has the tag, false otherwise.
+	 */
+	bool Window::hasTag(const std::string& tag) const {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		return tags.count(tag) > 0;
+	}
+
+	/**
+	 *  @brief  The getTags method returns the tags of this Window.
+	 *  @param tags The set of tags.
+	 */
+	void Window::getTags(std::unordered_set<std::string>& tags) const {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		tags = this->tags;
+	}
+
+	/**
+	 *  @brief  The removeAllTags method removes all the tags from this Window.
+	 */
+	void Window::removeAllTags() {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		for (auto& t : tags) {
+			std::unordered_map<std::string, std::unordered_set<WindowID>>::iterator it = taggedWindows.find(t);
+			if (it != taggedWindows.end()) {
+				it->second.erase(windowID);
+				if (it->second.empty())
+					taggedWindows.erase(it);
+			}
+		}
+		tags.clear();
+	}
+
 #ifdef VK_VERSION_1_0
 	/**
 	 *  @brief The createVulkanWindowSurface method creates a Vulkan surface for this window.
@@ -933,13 +1347,70 @@ namespace glfwm {
 	                                           VkSurfaceKHR* surface) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			throw std::runtime_error(
 			    std::string("Error. GLFW window does not exist. Impossible to create Vulkan surface."));
 		return glfwCreateWindowSurface(instance, glfwWindow, allocator, surface);
 	}
+
+	/**
+	 *  @brief  The createVulkanSurface method creates a Vulkan surface for this window, owned by this Window,
+	 * destroying the one previously created, if any.
+	 *  @param instance  The Vulkan instance to create the surface in.
+	 *  @param allocator The allocator to use, or nullptr to use the default allocator. It is also used for destroying
+	 * the surface.
+	 *  @return VK_SUCCESS if successful, or a Vulkan error code if an error occurred (see createVulkanWindowSurface).
+	 *  @note   The surface is destroyed by destroyVulkanSurface or, at the latest, when this Window is destroyed,
+	 * before its GLFW window. Thus the Vulkan instance must outlive this Window or the call to destroyVulkanSurface.
+	 */
+	VkResult Window::createVulkanSurface(VkInstance instance, const VkAllocationCallbacks* allocator) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
+#endif
+		destroyVulkanSurface();
+		VkResult result = createVulkanWindowSurface(instance, allocator, &vulkanSurface);
+		if (result == VK_SUCCESS) {
+			vulkanInstance = instance;
+			vulkanAllocator = allocator;
+		}
+		return result;
+	}
+
+	/**
+	 *  @brief  The getVulkanSurface method returns the Vulkan surface created by createVulkanSurface.
+	 *  @return The surface, or VK_NULL_HANDLE if none.
+	 */
+	VkSurfaceKHR Window::getVulkanSurface() const {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
+#endif
+		return vulkanSurface;
+	}
+
+	/**
+	 *  @brief  The destroyVulkanSurface method destroys the Vulkan surface created by createVulkanSurface, if any.
+	 *  @note   The swapchains created for the surface must have been destroyed already.
+	 */
+	void Window::destroyVulkanSurface() {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
+#endif
+		if (vulkanSurface == VK_NULL_HANDLE)
+			return;
+		// retrieved at run time, so as not to link the Vulkan loader
+		PFN_vkDestroySurfaceKHR destroySurface = reinterpret_cast<PFN_vkDestroySurfaceKHR>(
+		    glfwGetInstanceProcAddress(vulkanInstance, "vkDestroySurfaceKHR"));
+		if (destroySurface)
+			destroySurface(vulkanInstance, vulkanSurface, vulkanAllocator);
+		vulkanInstance = VK_NULL_HANDLE;
+		vulkanAllocator = nullptr;
+		vulkanSurface = VK_NULL_HANDLE;
+	}
 #endif
 
 #ifdef GLFW_EXPOSE_NATIVE_WIN32
@@ -951,7 +1422,7 @@ namespace glfwm {
 	HWND Window::getWin32Window() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return NULL;
@@ -968,7 +1439,7 @@ namespace glfwm {
 	id Window::getCocoaWindow() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return nil;
@@ -983,7 +1454,7 @@ namespace glfwm {
 	id Window::getCocoaView() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return nil;
@@ -1000,7 +1471,7 @@ namespace glfwm {
 	::Window Window::getX11Widow() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return None;
@@ -1017,7 +1488,7 @@ namespace glfwm {
 	struct wl_surface* Window::getWaylandWidow() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return nullptr;
@@ -1034,7 +1505,7 @@ namespace glfwm {
 	HGLRC Window::getWGLContext() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return NULL;
@@ -1051,7 +1522,7 @@ namespace glfwm {
 	id Window::getNSGLContext() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return nil;
@@ -1068,7 +1539,7 @@ namespace glfwm {
 	GLXContext Window::getGLXContext() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return NULL;
@@ -1083,7 +1554,7 @@ namespace glfwm {
 	GLXWindow Window::getGLXContext() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return None;
@@ -1100,7 +1571,7 @@ namespace glfwm {
 	EGLContext Window::getEGLContext() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return EGL_NO_CONTEXT;
@@ -1115,7 +1586,7 @@ namespace glfwm {
 	EGLSurface Window::getEGLSurface() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return EGL_NO_SURFACE;
@@ -1132,7 +1603,7 @@ namespace glfwm {
 	int Window::getOSMesaColorBuffer(int* width, int* height, int* format, void** buffer) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return GLFW_FALSE;
@@ -1147,7 +1618,7 @@ namespace glfwm {
 	int Window::getOSMesaDepthBuffer(int* width, int* height, int* bytesPerValue, void** buffer) const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return GLFW_FALSE;
@@ -1162,7 +1633,7 @@ namespace glfwm {
 	OSMesaContext Window::getOSMesaContext() const {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(mutexes[sharedMutexID].mutex);
+		std::lock_guard<ElidableRecursiveMutex> lock(mutexes[sharedMutexID].mutex);
 #endif
 		if (!glfwWindow)
 			return NULL;
@@ -1172,9 +1643,11 @@ namespace glfwm {
 
 #ifndef NO_MULTITHREADING
 	/**
-	 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+	 *  @brief  Mutex used to guarantee correct concurrent management of static activities. Lookups lock it shared,
+	 * creations and deletions exclusively. It is skipped by the main thread while concurrency is not active, see
+	 * Concurrency.
 	 */
-	std::recursive_mutex Window::globalMutex;
+	ElidableShardedMutex Window::globalMutex;
 
 	/**
 	 *  @brief  The container of mutexes.
@@ -1192,7 +1665,7 @@ namespace glfwm {
 	 */
 	Window::MutexID Window::newMutexID() {
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 		MutexID id = mutexes.size();
 		if (!freedMutexes.empty()) {
 			id = freedMutexes.front();
@@ -1204,13 +1677,25 @@ namespace glfwm {
 		return id;
 	}
 
+	/**
+	 *  @brief  The shareMutexID static method increases the number of users of a mutex already booked.
+	 *  @param id The ID of the mutex.
+	 *  @return The same ID.
+	 */
+	Window::MutexID Window::shareMutexID(const MutexID id) {
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+		mutexes[id].count++;
+		return id;
+	}
+
 	/**
 	 *  @brief  The decreaseMutexCount static method decreases the number of users of a mutex, eventually freeing it.
 	 *  @param id The ID of the mutex.
 	 */
 	void Window::decreaseMutexCount(const MutexID id) {
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 		if (id >= mutexes.size() || mutexes[id].count == 0)
 			return;
 		mutexes[id].count--;
@@ -1223,61 +1708,94 @@ namespace glfwm {
 #endif
 
 	/**
-	 *  @brief  The map between GLFWWindow pointers and WindowIDs.
+	 *  @brief  The ID of the Window whose context is current on the calling thread, or AllWindowIDs if none. The IDs of
+	 * deleted windows become stale, so a recycled GLFW window is never mistaken for the current one.
+	 */
+	thread_local WindowID Window::currentContextID = AllWindowIDs;
+
+	/**
+	 *  @brief  The drawables to prepare collected by prepareWindows on the calling thread, with their Window, and where
+	 * those of each Window start. They are reused frame after frame.
+	 */
+	thread_local std::vector<std::pair<WindowID, DrawablePointer>> Window::drawablesToPrepare;
+	thread_local std::vector<size_t> Window::prepareJobStarts;
+
+#ifndef NO_MULTITHREADING
+	std::atomic<unsigned long long> Window::contextSwitches(0);
+	std::atomic<unsigned long long> Window::avoidedContextSwitches(0);
+#else
+	unsigned long long Window::contextSwitches = 0;
+	unsigned long long Window::avoidedContextSwitches = 0;
+#endif
+
+	/**
+	 *  @brief  The container for collecting Windows, whose slots are identified by WindowIDs.
+	 */
+	SlotMap<WindowPointer> Window::windows;
+
+	/**
+	 *  @brief  The Windows deleted but possibly still borrowed, see borrowWindow.
+	 */
+	std::vector<WindowPointer> Window::retiredWindows;
+
+	/**
+	 *  @brief  The Windows with pending properties, see applyPendingProperties.
 	 */
-	Window::WindowMap Window::windowsMap;
+	std::vector<WindowID> Window::windowsWithPendingProperties;
 
+#ifndef NO_MULTITHREADING
 	/**
-	 *  @brief  The container for collecting Windows.
+	 *  @brief  Mutex used to guarantee correct concurrent management of windowsWithPendingProperties.
 	 */
-	std::deque<WindowPointer> Window::windows;
+	std::mutex Window::propertiesGlobalMutex;
+#endif
 
 	/**
-	 *  @brief  The container for reusing freed WindowIDs.
+	 *  @brief  The inverted index between tags and the Windows labelled with them.
 	 */
-	std::deque<WindowID> Window::freedWindowIDs;
+	std::unordered_map<std::string, std::unordered_set<WindowID>> Window::taggedWindows;
 
 	/**
-	 *  @brief  The newWindowID static method books a new or an old & freed ID for windows.
+	 *  @brief  The newWindowID static method books a new or an old & freed slot for windows.
 	 *  @return The booked WindowID.
 	 */
 	WindowID Window::newWindowID() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		WindowID id = windows.size();
-		if (!freedWindowIDs.empty()) {
-			id = freedWindowIDs.front();
-			freedWindowIDs.pop_front();
-		}
-		if (id >= windows.size())
-			windows.resize(id + 1);
-		return id;
+		return windows.acquire();
 	}
 
 	/**
 	 *  @brief  The newWindow static method allocates and creates a new Window, storing also internal pointers and
 	 * information in order to easily retrieve it later.
-	 *  @param width   The width of the new window, in screen space.
-	 *  @param height  The height of the new window, in screen space.
-	 *  @param title   The title of the new window.
-	 *  @param monitor The monitor for a fullscreen window, or a null pointer for a non-fullscreen window.
-	 *  @param share   The Window to share its context with, or a null pointer otherwise.
+	 *  @param width     The width of the new window, in screen space.
+	 *  @param height    The height of the new window, in screen space.
+	 *  @param title     The title of the new window.
+	 *  @param monitor   The monitor for a fullscreen window, or a null pointer for a non-fullscreen window.
+	 *  @param share     The Window to share its context with, or a null pointer otherwise.
+	 *  @param poolHints The hints set for creating the window, or a null pointer if not known. See the constructor.
 	 *  @return A WindowPointer to the new window.
 	 */
 	WindowPointer Window::newWindow(const int width,
 	                                const int height,
 	                                const std::string& title,
 	                                GLFWmonitor* monitor,
-	                                const WindowPointer& share) {
+	                                const WindowPointer& share,
+	                                const WindowPool::Hints* poolHints) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		WindowID id = newWindowID();
-		windows[id] = std::make_shared<Window>(id, width, height, title, monitor, share);
-		return windows[id];
+		try {
+			*windows.find(id) = std::make_shared<Window>(id, width, height, title, monitor, share, poolHints);
+		} catch (...) {
+			windows.release(id);
+			throw;
+		}
+		return windows.get(id);
 	}
 
 	/**
@@ -1287,38 +1805,112 @@ namespace glfwm {
 	 */
 	WindowPointer Window::getWindow(const WindowID id) {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		return windows.get(id);
+	}
+
+	/**
+	 *  @brief  The borrowWindow static method gives a non-owning reference to a Window given its ID, without touching
+	 * its reference count.
+	 *  @param id The WindowID of the Window to access.
+	 *  @return The reference to the requested Window, or a null reference if it does not exist.
+	 *  @note   Deleted Windows are kept alive until the main loop has started a new iteration and the frames in
+	 * progress in all the groups have ended. Hence the reference is valid until the end of the frame of the group it
+	 * has been borrowed by, or of the iteration of the main loop (e.g. a callback). Use getWindow for keeping a Window
+	 * longer.
+	 */
+	WindowRef Window::borrowWindow(const WindowID id) {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		if (id < windows.size())
-			return windows[id];
-		return WindowPointer(nullptr);
+		return WindowRef(windows.get(id).get());
+	}
+
+	/**
+	 *  @brief  The reclaimRetiredWindows static method releases the Windows deleted so far, once no frame in progress
+	 * can still be borrowing them.
+	 *  @note   This is called by the main loop at the beginning of each iteration and must not be called while drawing.
+	 */
+	void Window::reclaimRetiredWindows() {
+		std::vector<WindowPointer> retired;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+#endif
+			if (retiredWindows.empty())
+				return;
+			retired.swap(retiredWindows);
+		}
+		// frames started before the Windows were deleted may still be drawing them
+		WindowGroup::waitForFramesInProgress();
+		retired.clear();
+	}
+
+	/**
+	 *  @brief  The applyPendingProperties static method applies, in one pass, the titles, positions, sizes and
+	 * opacities set since its last call. Only the last value written to each property is applied, and only if it
+	 * differs from the current one.
+	 *  @note   This is called by the main loop once per iteration. This may only be called from the main thread.
+	 */
+	void Window::applyPendingProperties() {
+		std::vector<WindowID> ids;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(propertiesGlobalMutex);
+#endif
+			if (windowsWithPendingProperties.empty())
+				return;
+			ids.swap(windowsWithPendingProperties);
+		}
+		WindowRef w;
+		for (auto id : ids) {
+			w = borrowWindow(id);
+			if (w)
+				w->applyProperties();
+		}
 	}
 
 	/**
 	 *  @brief  The getWindowID static method gives the ID of a Window associated to a GLFWWindow object.
 	 *  @param w The GLFWWindow object pointer.
-	 *  @return The WindowPointer of the associated Window.
+	 *  @return The ID of the associated Window, or AllWindowIDs if none.
+	 *  @note   This does not lock, see fromGLFWWindow.
 	 */
 	WindowID Window::getWindowID(GLFWwindow* w) {
-#ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
-#endif
-		WindowMapIterator wIt = windowsMap.find(w);
-		if (wIt != windowsMap.end())
-			return wIt->second;
+		Window* window = fromGLFWWindow(w);
+		if (window)
+			return window->windowID;
 		return AllWindowIDs;
 	}
 
+	/**
+	 *  @brief  The fromGLFWWindow static method gives the Window associated to a GLFWWindow object, stored in its user
+	 * pointer, without locking.
+	 *  @param w The GLFWWindow object pointer.
+	 *  @return A non-owning pointer to the associated Window, or nullptr.
+	 *  @note   Windows are destroyed only in the main thread, so the pointer may be safely used there, e.g. in GLFW
+	 * callbacks, until the end of the current iteration of the main loop even if the Window is deleted meanwhile. Use
+	 * borrowWindow in other threads.
+	 */
+	Window* Window::fromGLFWWindow(GLFWwindow* w) {
+		if (w)
+			return static_cast<Window*>(glfwGetWindowUserPointer(w));
+		return nullptr;
+	}
+
 	/**
 	 *  @brief  The getALlWindowIDs static method returns the set of all the WindowID currently in use.
 	 *  @param wIDs The set of WindowIDs.
 	 */
 	void Window::getAllWindowIDs(std::unordered_set<WindowID>& wIDs) {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		wIDs.clear();
 		for (auto& w : windows)
@@ -1326,14 +1918,69 @@ namespace glfwm {
 				wIDs.insert(w->windowID);
 	}
 
+	/**
+	 *  @brief  The getTaggedWindowIDs static method returns the set of the WindowIDs labelled with a tag.
+	 *  @param tag  The tag.
+	 *  @param wIDs The set of WindowIDs.
+	 */
+	void Window::getTaggedWindowIDs(const std::string& tag, std::unordered_set<WindowID>& wIDs) {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		wIDs.clear();
+		std::unordered_map<std::string, std::unordered_set<WindowID>>::iterator it = taggedWindows.find(tag);
+		if (it != taggedWindows.end())
+			wIDs = it->second;
+	}
+
+	/**
+	 *  @brief  The getTaggedWindows static method returns the Windows labelled with a tag, for applying an operation
+	 * to all of them without holding any lock.
+	 *  @param tag The tag.
+	 *  @param ws  The list of Windows.
+	 */
+	void Window::getTaggedWindows(const std::string& tag, std::vector<WindowPointer>& ws) {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		ws.clear();
+		std::unordered_map<std::string, std::unordered_set<WindowID>>::iterator it = taggedWindows.find(tag);
+		if (it == taggedWindows.end())
+			return;
+		ws.reserve(it->second.size());
+		for (auto id : it->second)
+			if (windows.get(id))
+				ws.push_back(windows.get(id));
+	}
+
+	/**
+	 *  @brief  The clearTag static method removes a tag from all the Windows.
+	 *  @param tag The tag.
+	 */
+	void Window::clearTag(const std::string& tag) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		std::unordered_map<std::string, std::unordered_set<WindowID>>::iterator it = taggedWindows.find(tag);
+		if (it == taggedWindows.end())
+			return;
+		for (auto id : it->second)
+			if (windows.get(id))
+				windows.get(id)->tags.erase(tag);
+		taggedWindows.erase(it);
+	}
+
 	/**
 	 *  @brief  The isAnyWindowOpen static method says if there is any Window still open.
 	 *  @return true if is there any Window still open, false otherwise.
 	 */
 	bool Window::isAnyWindowOpen() {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		for (auto& w : windows)
 			if (w && !w->shouldClose())
@@ -1347,8 +1994,8 @@ namespace glfwm {
 	 */
 	void Window::windowsToClose(std::unordered_set<WindowID>& wtc) {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		wtc.clear();
 		for (auto& w : windows)
@@ -1363,12 +2010,12 @@ namespace glfwm {
 	void Window::deleteWindow(const WindowID id) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		if (id < windows.size() && windows[id]) {
-			windows[id]->destroy();
-			windows[id].reset();
-		}
+		// keep a reference, as destroying releases the slot
+		WindowPointer w = windows.get(id);
+		if (w)
+			w->destroy();
 	}
 
 	/**
@@ -1377,40 +2024,42 @@ namespace glfwm {
 	void Window::deleteAllWindows() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		windowsMap.clear();
-		windows.clear();
-		freedWindowIDs.clear();
+		// the Windows are destroyed after emptying the container, as destroying releases their slots
+		SlotMap<WindowPointer> deleted;
+		deleted.swap(windows);
+		deleted.clear();
+		retiredWindows.clear();
+		{
 #ifndef NO_MULTITHREADING
-		freedMutexes.clear();
-		mutexes.clear();
+			// acquire ownership
+			std::lock_guard<std::mutex> lockProperties(propertiesGlobalMutex);
 #endif
-	}
-
-	/**
-	 *  @brief  The unmapWindow static method removes the association between a GLFWWindow object and a Window.
-	 *  @param w The GLFWWindow object to unmap.
-	 */
-	void Window::unmapWindow(GLFWwindow* w) {
+			windowsWithPendingProperties.clear();
+		}
+		taggedWindows.clear();
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		freedMutexes.clear();
+		mutexes.clear();
 #endif
-		windowsMap.erase(w);
 	}
 
 	/**
-	 *  @brief  The freeWindowID frees an ID for a later reuse.
+	 *  @brief  The freeWindowID frees an ID for a later reuse. The ID becomes stale: it will not address any Window,
+	 * even after its slot has been reused.
 	 *  @param id The ID to free.
 	 */
 	void Window::freeWindowID(const WindowID id) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		std::deque<WindowID>::iterator pos = std::lower_bound(freedWindowIDs.begin(), freedWindowIDs.end(), id);
-		freedWindowIDs.insert(pos, id);
+		// keep the Window alive for those still borrowing it
+		WindowPointer* w = windows.find(id);
+		if (w && *w)
+			retiredWindows.push_back(*w);
+		windows.release(id);
 	}
 
 }
@@ -0,0 +1,117 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#include <GLFWM/window_config.hpp>
+
+namespace glfwm {
+
+	/**
+	 *  @brief  Constructor.
+	 *  @param width  The window width.
+	 *  @param height The window height.
+	 *  @param title  The window title.
+	 *  @note   All the event types are registered for callbacks, no monitor and no share, default hints.
+	 */
+	WindowConfig::WindowConfig(const int width, const int height, const std::string& title)
+	    : width(width), height(height), title(title), eventTypes(allEventTypes), monitor(nullptr), share(nullptr) {}
+
+	/**
+	 *  @brief  The setEventTypes method sets the event types to register callbacks for.
+	 *  @param eventTypes A mask corresponding to the list of event types.
+	 *  @return A reference to this, for chaining.
+	 */
+	WindowConfig& WindowConfig::setEventTypes(const EventBaseType eventTypes) {
+		this->eventTypes = eventTypes;
+		return *this;
+	}
+
+	/**
+	 *  @brief  The setMonitor method sets the monitor for fullscreen.
+	 *  @param monitor A pointer to a monitor for fullscreen, or NULL otherwise.
+	 *  @return A reference to this, for chaining.
+	 */
+	WindowConfig& WindowConfig::setMonitor(GLFWmonitor* monitor) {
+		this->monitor = monitor;
+		return *this;
+	}
+
+	/**
+	 *  @brief  The setShare method sets the window to share the context with.
+	 *  @param share A pointer to another window to share its context with, or NULL otherwise.
+	 *  @return A reference to this, for chaining.
+	 */
+	WindowConfig& WindowConfig::setShare(const WindowPointer& share) {
+		this->share = share;
+		return *this;
+	}
+
+	/**
+	 *  @brief  The setHint method sets a target hint to a given value, replacing the one previously set, if any.
+	 *  @param target The target hint.
+	 *  @param value  The value to set to the hint.
+	 *  @return A reference to this, for chaining.
+	 *  @note   The hints not set take their default values.
+	 */
+	WindowConfig& WindowConfig::setHint(const int target, const int value) {
+		for (auto& h : hints)
+			if (h.first == target) {
+				h.second = value;
+				return *this;
+			}
+		hints.push_back(Hint(target, value));
+		return *this;
+	}
+
+	/**
+	 *  @brief  The getWidth method returns the window width.
+	 *  @return The width.
+	 */
+	int WindowConfig::getWidth() const { return width; }
+
+	/**
+	 *  @brief  The getHeight method returns the window height.
+	 *  @return The height.
+	 */
+	int WindowConfig::getHeight() const { return height; }
+
+	/**
+	 *  @brief  The getTitle method returns the window title.
+	 *  @return The title.
+	 */
+	const std::string& WindowConfig::getTitle() const { return title; }
+
+	/**
+	 *  @brief  The getEventTypes method returns the event types to register callbacks for.
+	 *  @return A mask corresponding to the list of event types.
+	 */
+	EventBaseType WindowConfig::getEventTypes() const { return eventTypes; }
+
+	/**
+	 *  @brief  The getMonitor method returns the monitor for fullscreen.
+	 *  @return A pointer to the monitor, or NULL.
+	 */
+	GLFWmonitor* WindowConfig::getMonitor() const { return monitor; }
+
+	/**
+	 *  @brief  The getShare method returns the window to share the context with.
+	 *  @return A pointer to the window, or NULL.
+	 */
+	const WindowPointer& WindowConfig::getShare() const { return share; }
+
+	/**
+	 *  @brief  The getHints method returns the hints set, in the order they were first set.
+	 *  @return The list of hints.
+	 */
+	const std::vector<WindowConfig::Hint>& WindowConfig::getHints() const { return hints; }
+
+}
@@ -15,18 +15,74 @@
 
 namespace glfwm {
 
+	namespace {
+		/**
+		 *  @brief  The minimum duration of a statistics period, in seconds.
+		 */
+		const double statisticsPeriod = 1.0;
+
+#if defined(_WIN32)
+		using GLFinishFunction = void(__stdcall*)();
+#else
+		using GLFinishFunction = void (*)();
+#endif
+
+		/**
+		 *  @brief  The finishRendering function blocks until the rendering to the current context is complete.
+		 */
+		void finishRendering() {
+			// retrieved at run time, so as not to link OpenGL
+			GLFinishFunction finish = reinterpret_cast<GLFinishFunction>(glfwGetProcAddress("glFinish"));
+			if (finish)
+				finish();
+		}
+	}
+
 	/**
 	 *  @brief  Constructor. See newGroup for a reliable construction.
 	 *  @param  id The univoque ID for thiw WindowGroup. See newGroupID.
 	 */
 	WindowGroup::WindowGroup(const WindowGroupID id)
-	    : groupID(id)
+	    : groupID(id),
+	      parentGroupID(NoWindowGroupID),
+	      statisticsPeriodStart(std::chrono::steady_clock::now()),
+	      periodFrameCount(0),
+	      periodBusyTime(0.0)
 #ifndef NO_MULTITHREADING
 	      ,
+	      doPresent(false),
+	      presentStride(1),
+	      measuring(false),
+	      measureStart(0.0),
+	      cpuTime(0.0),
 	      doPoll(false),
-	      doLoop(false)
+	      doLoop(false),
+	      onExecutor(false),
+	      taskScheduled(false),
+	      paused(false),
+	      parked(false),
+	      frameInterval(0.0),
+	      vsyncPacing(false),
+	      frameDeadline(std::chrono::steady_clock::now()),
+	      timerPending(false),
+	      timerID(0)
 #endif
 	{
+#ifndef NO_MULTITHREADING
+		threadOptions.name = "glfwm-g" + std::to_string(getIndex(id));
+#endif
+		subtreeGroupIDs.set(getIndex(id));
+		statistics.framesPerSecond = 0.0;
+		statistics.idlePercentage = 100.0;
+		statistics.frameCount = 0;
+		statistics.swapSkew = 0.0;
+		statistics.stallCount = 0;
+		synchronizedPresentation = false;
+#ifndef NO_MULTITHREADING
+		parallelSwap = false;
+#else
+		timeBudget = 0.0;
+#endif
 	}
 
 	/**
@@ -40,17 +96,31 @@ namespace glfwm {
 	void WindowGroup::destroy() {
 #ifndef NO_MULTITHREADING
 		stopAndWait();
+		{
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(renderMutex);
+			stopPresenters();
+		}
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lockGlobal(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lockGlobal(globalMutex);
 		std::lock_guard<std::mutex> lockLocal(mutex);
 #endif
 		for (auto id : attachedWindows)
-			windowGroupMap[id] = NoWindowGroupID;
+			mapWindow(id, NoWindowGroupID);
 		attachedWindows.clear();
-		std::deque<WindowGroupID>::iterator pos = std::lower_bound(freedWindowGroupIDs.begin(),
-		                                                           freedWindowGroupIDs.end(),
-		                                                           groupID);
-		freedWindowGroupIDs.insert(pos, groupID);
+		// unlink from the hierarchy
+		if (parentGroupID != NoWindowGroupID || !childGroupIDs.empty()) {
+			if (windowGroups.get(parentGroupID))
+				windowGroups.get(parentGroupID)->childGroupIDs.erase(groupID);
+			parentGroupID = NoWindowGroupID;
+			for (auto id : childGroupIDs)
+				if (windowGroups.get(id))
+					windowGroups.get(id)->parentGroupID = NoWindowGroupID;
+			childGroupIDs.clear();
+			updateSubtreeGroups();
+		}
+		// the ID becomes stale, it does nothing if already released
+		windowGroups.release(groupID);
 	}
 
 	/**
@@ -67,11 +137,11 @@ namespace glfwm {
 	void WindowGroup::attachWindow(const WindowID windowID) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lockGlobal(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lockGlobal(globalMutex);
 		std::lock_guard<std::mutex> lockLocal(mutex);
 #endif
 		attachedWindows.insert(windowID);
-		windowGroupMap[windowID] = groupID;
+		mapWindow(windowID, groupID);
 	}
 
 	/**
@@ -81,11 +151,37 @@ namespace glfwm {
 	void WindowGroup::detachWindow(const WindowID windowID) {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lockGlobal(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lockGlobal(globalMutex);
 		std::lock_guard<std::mutex> lockLocal(mutex);
 #endif
 		if (attachedWindows.erase(windowID) > 0)
-			windowGroupMap[windowID] = NoWindowGroupID;
+			mapWindow(windowID, NoWindowGroupID);
+	}
+
+	/**
+	 *  @brief  The attachTaggedWindows method adds to this group all the Windows labelled with a tag.
+	 *  @param tag The tag, see Window::addTag.
+	 *  @note   The Windows are detached from their previous groups.
+	 */
+	void WindowGroup::attachTaggedWindows(const std::string& tag) {
+		std::unordered_set<WindowID> wIDs;
+		Window::getTaggedWindowIDs(tag, wIDs);
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lockGlobal(globalMutex);
+#endif
+		for (auto id : wIDs) {
+			WindowGroupMapIterator it = windowGroupMap.find(id);
+			if (it != windowGroupMap.end() && it->second != groupID && windowGroups.get(it->second))
+				windowGroups.get(it->second)->detachWindow(id);
+		}
+#ifndef NO_MULTITHREADING
+		std::lock_guard<std::mutex> lockLocal(mutex);
+#endif
+		for (auto id : wIDs) {
+			attachedWindows.insert(id);
+			mapWindow(id, groupID);
+		}
 	}
 
 	/**
@@ -100,6 +196,76 @@ namespace glfwm {
 		return attachedWindows.empty();
 	}
 
+	/**
+	 *  @brief  The attachGroup method nests a WindowGroup into this group: notifying this group for update (see
+	 * UpdateMap::notify with WholeGroupWindowIDs) updates also all the groups nested, directly or not, into it.
+	 *  @param childID The ID of the group to nest.
+	 *  @return true if the group has been nested, false if it does not exist or it is this group or one of its
+	 * ancestors.
+	 *  @note   A group can not be nested into more than one group at the same time: it is moved from the previous
+	 * one.
+	 */
+	bool WindowGroup::attachGroup(const WindowGroupID childID) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		WindowGroupPointer child = windowGroups.get(childID);
+		if (!child)
+			return false;
+		// nesting an ancestor would make a cycle
+		if (child->subtreeGroupIDs.test(getIndex(groupID)))
+			return false;
+		if (child->parentGroupID == groupID)
+			return true;
+		if (windowGroups.get(child->parentGroupID))
+			windowGroups.get(child->parentGroupID)->childGroupIDs.erase(childID);
+		child->parentGroupID = groupID;
+		childGroupIDs.insert(childID);
+		updateSubtreeGroups();
+		return true;
+	}
+
+	/**
+	 *  @brief  The detachGroup method removes a nested WindowGroup from this group.
+	 *  @param childID The ID of the nested group.
+	 */
+	void WindowGroup::detachGroup(const WindowGroupID childID) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		if (childGroupIDs.erase(childID) == 0)
+			return;
+		if (windowGroups.get(childID))
+			windowGroups.get(childID)->parentGroupID = NoWindowGroupID;
+		updateSubtreeGroups();
+	}
+
+	/**
+	 *  @brief  The getParentGroup method returns the ID of the group this group is nested into.
+	 *  @return The ID of the parent group, or NoWindowGroupID.
+	 */
+	WindowGroupID WindowGroup::getParentGroup() const {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		return parentGroupID;
+	}
+
+	/**
+	 *  @brief  The getChildGroups method returns the IDs of the groups directly nested into this group.
+	 *  @param gIDs The set of WindowGroupIDs.
+	 */
+	void WindowGroup::getChildGroups(std::unordered_set<WindowGroupID>& gIDs) const {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		gIDs = childGroupIDs;
+	}
+
 #ifndef NO_MULTITHREADING
 	/**
 	 *  @brief  The setPoll method sets this group's event processing to POLL or WAIT for events.
@@ -108,8 +274,12 @@ namespace glfwm {
 	void WindowGroup::setPoll(const bool poll) {
 		bool wasWaiting = !doPoll;
 		doPoll = poll;
-		if (wasWaiting && poll)
-			conditonVariable.notify_one();
+		if (wasWaiting && poll) {
+			if (onExecutor)
+				scheduleTask();
+			else
+				conditonVariable.notify_one();
+		}
 	}
 
 	/**
@@ -118,26 +288,229 @@ namespace glfwm {
 	 */
 	bool WindowGroup::isPolling() const { return doPoll; }
 
+	/**
+	 *  @brief  The setTargetFrameRate method limits the rate at which this group's loop redraws its Windows while
+	 * polling, so that it sleeps between frames instead of spinning.
+	 *  @param framesPerSecond The maximum number of frames per second. 0 means no limit.
+	 *  @note   Windows set to update are still drawn as soon as possible. This has effect only when running
+	 * concurrently.
+	 */
+	void WindowGroup::setTargetFrameRate(const double framesPerSecond) {
+		frameInterval = framesPerSecond > 0.0 ? 1.0 / framesPerSecond : 0.0;
+		{
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(mutex);
+			frameDeadline = std::chrono::steady_clock::now();
+			if (timerPending && Executor::cancel(timerID))
+				timerPending = false;
+		}
+		if (onExecutor)
+			scheduleTask();
+		else
+			conditonVariable.notify_one();
+	}
+
+	/**
+	 *  @brief  The getTargetFrameRate method returns the maximum number of frames per second while polling.
+	 *  @return The target frame rate, or 0 if not limited.
+	 */
+	double WindowGroup::getTargetFrameRate() const {
+		const double interval = frameInterval;
+		return interval > 0.0 ? 1.0 / interval : 0.0;
+	}
+
+	/**
+	 *  @brief  The setVSyncPacing method makes the frames drawn while polling follow a fixed cadence at the target
+	 * frame rate, as the vertical synchronization of a monitor does, instead of just keeping a minimum interval
+	 * between them. If no target frame rate has been set, the refresh rate of the primary monitor is used.
+	 *  @param vsync true for a fixed cadence, false for a minimum interval between frames.
+	 *  @note   This may only be called from the main thread.
+	 */
+	void WindowGroup::setVSyncPacing(const bool vsync) {
+		vsyncPacing = vsync;
+		if (vsync && frameInterval == 0.0) {
+			GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+			const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+			if (mode && mode->refreshRate > 0)
+				setTargetFrameRate(mode->refreshRate);
+			else
+				std::cout << "Warning. Unable to retrieve the refresh rate of the primary monitor. Set a target frame "
+				             "rate to enable VSync pacing."
+				          << std::endl;
+		}
+	}
+
+	/**
+	 *  @brief  The isVSyncPacing method says if the frames drawn while polling follow a fixed cadence.
+	 *  @return true for a fixed cadence, false for a minimum interval between frames.
+	 */
+	bool WindowGroup::isVSyncPacing() const { return vsyncPacing; }
+
 	/**
 	 *  @brief  The runLoopConcurrently method starts the execution of this group loop in another thread, if not yet
-	 * started.
+	 * started, or resumes it if paused.
 	 *  @note   Use notifyEvents, stop, isRunningConcurrently and join to sinchronize.
 	 */
 	void WindowGroup::runLoopConcurrently() {
 		std::lock_guard<std::mutex> lock(joinMutex);
+		if (onExecutor)
+			return;
+		if (threadOfLoop.joinable()) {
+			if (doLoop) {
+				resume();
+				return;
+			}
+			// the thread has been told to stop, but not joined yet
+			threadOfLoop.join();
+		}
+		paused = false;
+		parked = false;
+		doLoop = true;
+		Concurrency::enable();
+		threadOfLoop = std::thread(&WindowGroup::concurrentLoop, this, threadOptions);
+	}
+
+	/**
+	 *  @brief  The runLoopOnExecutor method starts the execution of this group loop as a sequence of tasks on the
+	 * shared Executor, if not yet started, or resumes it if paused.
+	 *  @note   The Windows of this group are still drawn serially, but an idle group does not occupy any thread. Use
+	 * stop and stopAndWait to end it as with runLoopConcurrently.
+	 */
+	void WindowGroup::runLoopOnExecutor() {
+		std::lock_guard<std::mutex> lock(joinMutex);
+		if (onExecutor) {
+			resume();
+			return;
+		}
 		if (threadOfLoop.joinable()) {
-			doLoop = true;
-			threadOfLoop = std::thread(&WindowGroup::concurrentLoop, this);
+			if (doLoop)
+				return;
+			// the thread has been told to stop, but not joined yet
+			threadOfLoop.join();
+		}
+		paused = false;
+		doLoop = true;
+		onExecutor = true;
+		scheduleTask();
+	}
+
+	/**
+	 *  @brief  The pause method suspends the loop running concurrently at the end of the current frame, keeping its
+	 * thread parked, and sinchronizes with it. Meanwhile, the group is processed by the calling thread as if not
+	 * running concurrently.
+	 *  @note   Pausing and resuming is much cheaper than stopping and restarting the loop.
+	 */
+	void WindowGroup::pause() {
+		std::lock_guard<std::mutex> joinLock(joinMutex);
+		if (!doLoop || paused || !(threadOfLoop.joinable() || onExecutor))
+			return;
+		std::unique_lock<std::mutex> lock(mutex);
+		paused = true;
+		if (onExecutor) {
+			if (timerPending && Executor::cancel(timerID))
+				timerPending = false;
+			waitTasks(lock);
+		} else {
+			conditonVariable.notify_one();
+			taskConditionVariable.wait(lock, [this]() -> bool { return parked || !doLoop; });
 		}
 	}
 
 	/**
-	 *  @brief  The isRunningConcurrently method says if the loop is running on another thread.
-	 *  @return true if running concurrently, false otherwise.
+	 *  @brief  The resume method restarts the loop suspended by pause.
+	 */
+	void WindowGroup::resume() {
+		{
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!paused)
+				return;
+			paused = false;
+		}
+		if (onExecutor)
+			scheduleTask();
+		else
+			conditonVariable.notify_one();
+	}
+
+	/**
+	 *  @brief  The isPaused method says if the loop running concurrently is suspended.
+	 *  @return true if paused, false otherwise.
+	 */
+	bool WindowGroup::isPaused() const { return paused; }
+
+	/**
+	 *  @brief  The isRunningConcurrently method says if the loop is running on another thread, either dedicated or
+	 * belonging to the Executor.
+	 *  @return true if running concurrently, false otherwise or if paused.
 	 */
 	bool WindowGroup::isRunningConcurrently() const {
 		std::lock_guard<std::mutex> lock(joinMutex);
-		return threadOfLoop.joinable();
+		return (threadOfLoop.joinable() || onExecutor) && !paused;
+	}
+
+	/**
+	 *  @brief  The isRunningOnExecutor method says if the loop is running as a sequence of tasks on the Executor.
+	 *  @return true if running on the Executor, false otherwise.
+	 */
+	bool WindowGroup::isRunningOnExecutor() const { return onExecutor; }
+
+	/**
+	 *  @brief  The setThreadName method sets the name of the thread running this group loop, as shown by debuggers
+	 * and profilers. The default is glfwm-g followed by the slot index of this group.
+	 *  @param name The name of the thread.
+	 *  @note   It takes effect at the next runLoopConcurrently.
+	 */
+	void WindowGroup::setThreadName(const std::string& name) {
+		std::lock_guard<std::mutex> lock(joinMutex);
+		threadOptions.name = name;
+	}
+
+	/**
+	 *  @brief  The getThreadName method returns the name of the thread running this group loop.
+	 *  @return The name of the thread.
+	 */
+	std::string WindowGroup::getThreadName() const {
+		std::lock_guard<std::mutex> lock(joinMutex);
+		return threadOptions.name;
+	}
+
+	/**
+	 *  @brief  The setThreadAffinity method pins the thread running this group loop to a set of CPUs.
+	 *  @param cpus The indices of the CPUs the thread is allowed to run on. Empty means any.
+	 *  @note   It takes effect at the next runLoopConcurrently. Not supported on macOS.
+	 */
+	void WindowGroup::setThreadAffinity(const std::vector<unsigned int>& cpus) {
+		std::lock_guard<std::mutex> lock(joinMutex);
+		threadOptions.cpus = cpus;
+	}
+
+	/**
+	 *  @brief  The getThreadAffinity method returns the set of CPUs the thread running this group loop is pinned to.
+	 *  @return The indices of the CPUs, or an empty set if not pinned.
+	 */
+	std::vector<unsigned int> WindowGroup::getThreadAffinity() const {
+		std::lock_guard<std::mutex> lock(joinMutex);
+		return threadOptions.cpus;
+	}
+
+	/**
+	 *  @brief  The setThreadPriority method changes the scheduling priority of the thread running this group loop.
+	 *  @param priority The scheduling priority.
+	 *  @note   It takes effect at the next runLoopConcurrently. Raising the priority may require privileges.
+	 */
+	void WindowGroup::setThreadPriority(const ThreadPriority priority) {
+		std::lock_guard<std::mutex> lock(joinMutex);
+		threadOptions.priority = priority;
+	}
+
+	/**
+	 *  @brief  The getThreadPriority method returns the scheduling priority of the thread running this group loop.
+	 *  @return The scheduling priority.
+	 */
+	ThreadPriority WindowGroup::getThreadPriority() const {
+		std::lock_guard<std::mutex> lock(joinMutex);
+		return threadOptions.priority;
 	}
 
 	/**
@@ -146,7 +519,12 @@ namespace glfwm {
 	 * need to sinchronize.
 	 */
 	void WindowGroup::stop() {
-		doLoop = false;
+		{
+			// acquire ownership, so that the notification can not be lost
+			std::lock_guard<std::mutex> lock(mutex);
+			doLoop = false;
+			onExecutor = false;
+		}
 		conditonVariable.notify_one();
 	}
 
@@ -157,21 +535,38 @@ namespace glfwm {
 	void WindowGroup::stopAndWait() {
 		std::lock_guard<std::mutex> lock(joinMutex);
 		if (threadOfLoop.joinable()) {
-			doLoop = false;
+			{
+				// acquire ownership, so that the notification can not be lost
+				std::lock_guard<std::mutex> taskLock(mutex);
+				doLoop = false;
+			}
 			conditonVariable.notify_one();
 			threadOfLoop.join();
 		}
+		if (onExecutor || taskScheduled || timerPending) {
+			doLoop = false;
+			onExecutor = false;
+			std::unique_lock<std::mutex> taskLock(mutex);
+			if (timerPending && Executor::cancel(timerID))
+				timerPending = false;
+			waitTasks(taskLock);
+		}
 	}
 
 	/**
 	 *  @brief  The concurrentLoop method is the function to be executed on another thread and that represents a loop of
 	 * event processing and drawing.
+	 *  @param options The options to apply to the thread.
 	 */
-	void WindowGroup::concurrentLoop() {
+	void WindowGroup::concurrentLoop(const ThreadOptions options) {
+		options.applyToCurrentThread();
 		while (doLoop) {
 			waitEvents();
 			updateWindows();
 		}
+		// release the contexts, as the Windows are going to be drawn by other threads
+		Window::releaseCurrentContext();
+		Concurrency::disable();
 	}
 
 	/**
@@ -179,10 +574,204 @@ namespace glfwm {
 	 */
 	void WindowGroup::waitEvents() {
 		std::unique_lock<std::mutex> lock(mutex);
-		conditonVariable.wait(lock, [this]() -> bool { return !doLoop || doPoll || !windowsToUpdate.empty(); });
+		while (doLoop) {
+			if (paused) {
+				if (!parked) {
+					// release the contexts, as the Windows are going to be drawn by other threads
+					Window::releaseCurrentContext();
+					parked = true;
+					taskConditionVariable.notify_all();
+				}
+				conditonVariable.wait(lock);
+				continue;
+			}
+			parked = false;
+			if (!windowsToUpdate.empty())
+				return;
+			if (!doPoll)
+				conditonVariable.wait(lock);
+			else if (frameInterval == 0.0 || std::chrono::steady_clock::now() >= frameDeadline)
+				return;
+			else
+				// sleep until the next frame is due, unless some Windows have to be updated before
+				conditonVariable.wait_until(lock, frameDeadline);
+		}
+	}
+
+	/**
+	 *  @brief  The scheduleTask method submits a step of this group loop to the Executor, unless one is already
+	 * scheduled.
+	 */
+	void WindowGroup::scheduleTask() {
+		if (paused)
+			return;
+		bool expected = false;
+		if (taskScheduled.compare_exchange_strong(expected, true))
+			Executor::submit(std::bind(&WindowGroup::executorTask, this));
+	}
+
+	/**
+	 *  @brief  The executorTask method is a single step of the loop executed by the Executor: it draws the Windows to
+	 * update and submits itself again while there is still work to do.
+	 */
+	void WindowGroup::executorTask() {
+		if (doLoop && !paused) {
+			updateWindows();
+			// release the contexts, as the next step may be executed by another worker thread
+			Window::releaseCurrentContext();
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		const bool frameDue = doPoll
+		                      && (frameInterval == 0.0 || std::chrono::steady_clock::now() >= frameDeadline);
+		if (doLoop && !paused && (frameDue || !windowsToUpdate.empty())) {
+			lock.unlock();
+			Executor::submit(std::bind(&WindowGroup::executorTask, this));
+			return;
+		}
+		if (doLoop && !paused && doPoll && !timerPending) {
+			// do not occupy the worker until the next frame is due
+			timerPending = true;
+			timerID = Executor::submitAt(frameDeadline, std::bind(&WindowGroup::frameTimerTask, this));
+		}
+		taskScheduled = false;
+		taskConditionVariable.notify_all();
+	}
+
+	/**
+	 *  @brief  The frameTimerTask method is the delayed task executed by the Executor when the next frame is due.
+	 */
+	void WindowGroup::frameTimerTask() {
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(mutex);
+		if (doLoop && !paused)
+			scheduleTask();
+		timerPending = false;
+		taskConditionVariable.notify_all();
+	}
+
+	/**
+	 *  @brief  The waitTasks method waits for the end of the step and of the delayed task of this group scheduled on the
+	 * Executor. To be called holding mutex.
+	 *  @param lock The lock of mutex.
+	 */
+	void WindowGroup::waitTasks(std::unique_lock<std::mutex>& lock) {
+		while (taskScheduled || timerPending) {
+			// the tasks discarded by Executor::stop never end, nor notify: they are dropped once the workers are joined
+			if (Executor::getThreadCount() == 0) {
+				taskScheduled = false;
+				timerPending = false;
+				return;
+			}
+			taskConditionVariable.wait_for(lock, std::chrono::milliseconds(10));
+		}
+	}
+
+	/**
+	 *  @brief  The advanceFrameDeadline method computes the time at which the frame after the current one is due.
+	 *  @param now The current time.
+	 */
+	void WindowGroup::advanceFrameDeadline(const std::chrono::steady_clock::time_point& now) {
+		const std::chrono::steady_clock::duration interval =
+		    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		        std::chrono::duration<double>(frameInterval.load()));
+		if (interval.count() <= 0) {
+			frameDeadline = now;
+			return;
+		}
+		if (vsyncPacing) {
+			// keep the cadence, skipping the intervals already missed
+			frameDeadline += interval;
+			if (frameDeadline <= now)
+				frameDeadline += interval * ((now - frameDeadline) / interval + 1);
+		} else {
+			frameDeadline = now + interval;
+		}
+	}
+
+	/**
+	 *  @brief  The startPresenters method makes sure there are enough presenters to swap a given number of Windows in
+	 * parallel.
+	 *  @param count The number of presenters required.
+	 */
+	void WindowGroup::startPresenters(const size_t count) {
+		if (presenters.size() >= count)
+			return;
+		stopPresenters();
+		presentBarrier.reset(new Barrier(count + 1));
+		presentStride = count + 1;
+		doPresent = true;
+		for (size_t i = 0; i < count; ++i) {
+			Concurrency::enable();
+			presenters.emplace_back(&WindowGroup::presenterLoop, this, i);
+		}
+	}
+
+	/**
+	 *  @brief  The stopPresenters method stops and joins the presenters.
+	 */
+	void WindowGroup::stopPresenters() {
+		if (presenters.empty())
+			return;
+		doPresent = false;
+		presentBarrier->arriveAndWait();
+		for (auto& t : presenters)
+			t.join();
+		presenters.clear();
+		presentBarrier.reset();
+		presentStride = 1;
+	}
+
+	/**
+	 *  @brief  The presenterLoop method is the function executed by each presenter.
+	 *  @param index The index of the presenter.
+	 */
+	void WindowGroup::presenterLoop(const size_t index) {
+		// the CPU affinity and the priority are inherited from the thread of this group
+		ThreadOptions options;
+		options.name = "glfwm-g" + std::to_string(getIndex(groupID)) + "p" + std::to_string(index);
+		options.applyToCurrentThread();
+		while (true) {
+			presentBarrier->arriveAndWait();
+			if (!doPresent)
+				break;
+			// the thread of this group swaps the first Window
+			swapWindows(index + 1, presentStride);
+			presentBarrier->arriveAndWait();
+		}
+		Concurrency::disable();
 	}
 #endif
 
+#ifdef NO_MULTITHREADING
+	/**
+	 *  @brief  The setTimeBudget method limits the time this group may spend drawing in each iteration of the main
+	 * loop, so that a heavy group does not delay the handling of events. The Windows left to draw are carried over to
+	 * the next iterations.
+	 *  @param seconds The maximum time per iteration, in seconds. 0 means no limit.
+	 *  @note   At least one Window is drawn per iteration. Synchronized presentations are never split.
+	 */
+	void WindowGroup::setTimeBudget(const double seconds) { timeBudget = std::max(seconds, 0.0); }
+
+	/**
+	 *  @brief  The getTimeBudget method returns the maximum time this group may spend drawing in each iteration of the
+	 * main loop.
+	 *  @return The time budget, in seconds, or 0 if not limited.
+	 */
+	double WindowGroup::getTimeBudget() const { return timeBudget; }
+#endif
+
+	/**
+	 *  @brief  The hasPendingUpdates method says if some Windows of this group are waiting to be drawn.
+	 *  @return true if there are Windows to update, false otherwise.
+	 */
+	bool WindowGroup::hasPendingUpdates() const {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(mutex);
+#endif
+		return !windowsToUpdate.empty();
+	}
+
 	/**
 	 *  @brief  The setWindowToUpdate method adds the window with ID wID to be updated.
 	 *  @param wID The ID of the Window to update.
@@ -202,61 +791,301 @@ namespace glfwm {
 	void WindowGroup::process() {
 #ifndef NO_MULTITHREADING
 		if (isRunningConcurrently()) {
-			if (!doPoll)
+			if (onExecutor)
+				scheduleTask();
+			else
+				// a polling loop may be sleeping until its next frame is due
 				conditonVariable.notify_one();
 			return;
 		}
+		if (paused) {
+			updateWindows();
+			// release the contexts, as the Windows are going to be drawn by the loop again once resumed
+			Window::releaseCurrentContext();
+			return;
+		}
 #endif
 		updateWindows();
 	}
 
+	/**
+	 *  @brief  The getStatistics method returns the achieved frame rate and the time spent idle by this group.
+	 *  @return The current statistics of this group.
+	 */
+	WindowGroup::Statistics WindowGroup::getStatistics() const {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+#endif
+		updateStatistics(std::chrono::steady_clock::now());
+		return statistics;
+	}
+
 	/**
 	 *  @brief  The updateWindows method calls the draw method of the Windows in windowsToUpdate.
 	 */
 	void WindowGroup::updateWindows() {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::mutex> lock(mutex);
+		// acquire ownership of the drawing only: windows can still be set to update meanwhile
+		std::lock_guard<std::mutex> renderLock(renderMutex);
 #endif
-		WindowPointer w;
-		if (
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 #ifndef NO_MULTITHREADING
-		    doPoll ||
+		// let the contention detector know which group is waiting for the contexts
+		const WindowGroupID previousGroup = ContentionDetector::setCurrentGroup(groupID);
+		// beat this group's heartbeat while drawing
+		const WindowGroupID previousLoop = Watchdog::setCurrentLoop(groupID);
+		measuring = LoadBalancer::isEnabled();
+		const double startCPUTime = measuring ? LoadBalancer::getThreadCPUTime() : 0.0;
+		moveWindows();
+#endif
+		windowsToDraw.clear();
+		windowsToForward.clear();
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(mutex);
+#endif
+			windowsBeingUpdated.swap(windowsToUpdate);
+			bool wholeGroup = windowsBeingUpdated.find(WholeGroupWindowIDs) != windowsBeingUpdated.end()
+			                  || windowsBeingUpdated.find(AllWindowIDs) != windowsBeingUpdated.end();
+#ifndef NO_MULTITHREADING
+			if (doPoll && (frameInterval == 0.0 || start >= frameDeadline)) {
+				wholeGroup = true;
+				advanceFrameDeadline(start);
+			}
+#endif
+			if (wholeGroup)
+				windowsToDraw.assign(attachedWindows.begin(), attachedWindows.end());
+			else
+				for (auto id : windowsBeingUpdated)
+					if (attachedWindows.find(id) != attachedWindows.end())
+						windowsToDraw.push_back(id);
+					else
+						windowsToForward.push_back(id);
+		}
+		windowsBeingUpdated.clear();
+		for (auto id : windowsToForward)
+			UpdateMap::notify(AnyWindowGroupID, id);
+		if (!windowsToDraw.empty()) {
+			// run the CPU side work of all the windows in parallel, before drawing any of them
+			FrameInfo frame;
+			frame.groupID = groupID;
+			{
+#ifndef NO_MULTITHREADING
+				// acquire ownership
+				std::lock_guard<std::mutex> lock(statisticsMutex);
+#endif
+				frame.frameIndex = statistics.frameCount;
+			}
+			frame.time = start;
+			Window::prepareWindows(windowsToDraw, frame);
+		}
+		WindowRef w;
+		size_t drawn = 0;
+		if (synchronizedPresentation)
+			drawn = presentTogether();
+		else
+			for (size_t i = 0; i < windowsToDraw.size(); ++i) {
+				const WindowID id = windowsToDraw[i];
+#ifdef NO_MULTITHREADING
+				// out of time budget: carry the remaining windows over to the next iteration
+				if (timeBudget > 0.0 && drawn > 0
+				    && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= timeBudget) {
+					windowsToUpdate.insert(windowsToDraw.begin() + i, windowsToDraw.end());
+					break;
+				}
 #endif
-		    windowsToUpdate.find(WholeGroupWindowIDs) != windowsToUpdate.end()
-		    || windowsToUpdate.find(AllWindowIDs) != windowsToUpdate.end())
-			for (auto id : attachedWindows) {
-				w = Window::getWindow(id);
+				w = Window::borrowWindow(id);
+				// the window may have been deleted meanwhile
+				if (!w)
+					continue;
+				beginMeasure();
 				w->makeContextCurrent();
 				w->draw();
 				w->swapBuffers();
 				w->doneCurrentContext();
+				endMeasure(id);
+				++drawn;
 			}
-		else
-			for (auto id : windowsToUpdate)
-				if (attachedWindows.find(id) != attachedWindows.end()) {
-					w = Window::getWindow(id);
-					w->makeContextCurrent();
-					w->draw();
-					w->swapBuffers();
-					w->doneCurrentContext();
-				} else {
-					UpdateMap::notify(AnyWindowGroupID, id);
-				}
-		windowsToUpdate.clear();
+#ifndef NO_MULTITHREADING
+		if (measuring) {
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(statisticsMutex);
+			for (auto& m : measuredCPUTimes)
+				windowCPUTimes[m.first] += m.second;
+			cpuTime += LoadBalancer::getThreadCPUTime() - startCPUTime;
+			measuredCPUTimes.clear();
+		}
+		ContentionDetector::setCurrentGroup(previousGroup);
+		Watchdog::setCurrentLoop(previousLoop);
+#endif
+		if (drawn > 0)
+			recordFrame(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
 	}
 
-	// static stuff
+	/**
+	 *  @brief  The beginMeasure method starts measuring the CPU time spent drawing a Window, if requested by the
+	 * LoadBalancer.
+	 */
+	void WindowGroup::beginMeasure() {
+#ifndef NO_MULTITHREADING
+		if (measuring)
+			measureStart = LoadBalancer::getThreadCPUTime();
+#endif
+	}
+
+	/**
+	 *  @brief  The endMeasure method stops measuring the CPU time spent drawing a Window.
+	 *  @param wID The ID of the Window drawn.
+	 */
+	void WindowGroup::endMeasure(const WindowID wID) {
+#ifndef NO_MULTITHREADING
+		if (measuring)
+			measuredCPUTimes.push_back(std::make_pair(wID, LoadBalancer::getThreadCPUTime() - measureStart));
+#else
+		(void)wID;
+#endif
+	}
+
+	/**
+	 *  @brief  The setSynchronizedPresentation method makes this group present its Windows together: all of them are
+	 * drawn and finished first, then their buffers are swapped back-to-back.
+	 *  @param synchronized true for presenting the Windows together, false for drawing and swapping each in turn.
+	 *  @param parallel     true for issuing the swaps from parallel threads, one per Window, false for issuing them
+	 * from the thread of this group. It is ignored if NO_MULTITHREADING is defined.
+	 *  @note   See Statistics::swapSkew for the measured time between the first and the last swap.
+	 */
+	void WindowGroup::setSynchronizedPresentation(const bool synchronized, const bool parallel) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(renderMutex);
+		parallelSwap = parallel;
+		if (!synchronized || !parallel)
+			stopPresenters();
+#else
+		(void)parallel;
+#endif
+		synchronizedPresentation = synchronized;
+	}
+
+	/**
+	 *  @brief  The isSynchronizedPresentation method says if this group presents its Windows together.
+	 *  @return true if the Windows are presented together, false otherwise.
+	 */
+	bool WindowGroup::isSynchronizedPresentation() const { return synchronizedPresentation; }
+
+	/**
+	 *  @brief  The presentTogether method draws all the Windows in windowsToDraw, waits for the completion of their
+	 * rendering and then swaps their buffers back-to-back.
+	 *  @return The number of Windows presented.
+	 */
+	size_t WindowGroup::presentTogether() {
+		windowsToPresent.clear();
+		WindowRef w;
+		for (auto id : windowsToDraw) {
+			w = Window::borrowWindow(id);
+			// the window may have been deleted meanwhile
+			if (!w)
+				continue;
+			beginMeasure();
+			w->makeContextCurrent();
+			w->draw();
+			if (w->hasContext())
+				finishRendering();
+			w->doneCurrentContext();
+			endMeasure(id);
+			windowsToPresent.push_back(w);
+		}
+		if (windowsToPresent.empty())
+			return 0;
+		// release the last context, as the swaps may be issued by other threads
+		Window::releaseCurrentContext();
+		swapTimes.resize(windowsToPresent.size());
+#ifndef NO_MULTITHREADING
+		if (parallelSwap && windowsToPresent.size() > 1) {
+			startPresenters(windowsToPresent.size() - 1);
+			// start the swaps together, then wait for all of them to return
+			presentBarrier->arriveAndWait();
+			swapWindows(0, presentStride);
+			presentBarrier->arriveAndWait();
+		} else
+#endif
+			swapWindows(0, 1);
+		const size_t count = windowsToPresent.size();
+		auto range = std::minmax_element(swapTimes.begin(), swapTimes.end());
+		{
+#ifndef NO_MULTITHREADING
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(statisticsMutex);
+#endif
+			statistics.swapSkew = std::chrono::duration<double>(*range.second - *range.first).count();
+		}
+		windowsToPresent.clear();
+		return count;
+	}
 
 	/**
-	 *  @brief  The container of WindowGroups.
+	 *  @brief  The swapWindows method swaps the buffers of a subset of the Windows in windowsToPresent.
+	 *  @param first  The index of the first Window to swap.
+	 *  @param stride The distance between the indices of two consecutive Windows to swap.
 	 */
-	std::deque<WindowGroupPointer> WindowGroup::windowGroups;
+	void WindowGroup::swapWindows(const size_t first, const size_t stride) {
+		for (size_t i = first; i < windowsToPresent.size(); i += stride) {
+			windowsToPresent[i]->makeContextCurrent();
+			windowsToPresent[i]->swapBuffers();
+			swapTimes[i] = std::chrono::steady_clock::now();
+			windowsToPresent[i]->doneCurrentContext(false);
+		}
+	}
 
 	/**
-	 *  @brief  The container for reusing freed WindowGroupID. It is kept sorted.
+	 *  @brief  The recordFrame method accounts a drawn frame in the statistics.
+	 *  @param busyTime The time spent drawing the frame, in seconds.
 	 */
-	std::deque<WindowGroupID> WindowGroup::freedWindowGroupIDs;
+	void WindowGroup::recordFrame(const double busyTime) {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+#endif
+		++periodFrameCount;
+		++statistics.frameCount;
+		periodBusyTime += busyTime;
+		updateStatistics(std::chrono::steady_clock::now());
+	}
+
+	/**
+	 *  @brief  The recordStall method accounts a stall of this group's loop in the statistics.
+	 */
+	void WindowGroup::recordStall() {
+#ifndef NO_MULTITHREADING
+		// acquire ownership
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+#endif
+		++statistics.stallCount;
+	}
+
+	/**
+	 *  @brief  The updateStatistics method publishes the statistics of the last period, if elapsed.
+	 *  @param now The current time.
+	 */
+	void WindowGroup::updateStatistics(const std::chrono::steady_clock::time_point& now) const {
+		const double elapsed = std::chrono::duration<double>(now - statisticsPeriodStart).count();
+		if (elapsed < statisticsPeriod)
+			return;
+		statistics.framesPerSecond = periodFrameCount / elapsed;
+		statistics.idlePercentage = 100.0 * std::max(0.0, 1.0 - periodBusyTime / elapsed);
+		statisticsPeriodStart = now;
+		periodFrameCount = 0;
+		periodBusyTime = 0.0;
+	}
+
+	// static stuff
+
+	/**
+	 *  @brief  The container of WindowGroups, whose slots are identified by WindowGroupIDs.
+	 */
+	SlotMap<WindowGroupPointer> WindowGroup::windowGroups;
 
 	/**
 	 *  @brief  The map between Windows and WindowGroups.
@@ -265,9 +1094,50 @@ namespace glfwm {
 
 #ifndef NO_MULTITHREADING
 	/**
-	 *  @brief  Mutex used to guarantee correct concurrent management of static activities.
+	 *  @brief  Mutex used to guarantee correct concurrent management of static activities. Lookups lock it shared,
+	 * creations, deletions and changes of membership exclusively.
+	 */
+	ElidableShardedMutex WindowGroup::globalMutex;
+
+	/**
+	 *  @brief  Flag telling whether new Windows are attached to lanes.
+	 */
+	std::atomic<bool> WindowGroup::useShareGroupLanes(false);
+
+	/**
+	 *  @brief  The map between share groups and their lanes.
+	 */
+	std::unordered_map<size_t, WindowGroupID> WindowGroup::shareGroupLanes;
+#endif
+
+#ifndef NO_MULTITHREADING
+	/**
+	 *  @brief  The moveWindows method moves the Windows in windowsToMove to their destination groups, releasing the
+	 * context current on the calling thread first, so that the destination threads can make it current. To be called
+	 * by the thread drawing this group, holding renderMutex.
 	 */
-	std::recursive_mutex WindowGroup::globalMutex;
+	void WindowGroup::moveWindows() {
+		std::vector<std::pair<WindowID, WindowGroupID>> moves;
+		{
+			// acquire ownership
+			std::lock_guard<std::mutex> lock(mutex);
+			if (windowsToMove.empty())
+				return;
+			moves.swap(windowsToMove);
+		}
+		Window::releaseCurrentContext();
+		for (auto& m : moves) {
+			WindowGroupPointer to = getGroup(m.second);
+			// acquire ownership, so that the Window is never seen detached from both the groups
+			std::lock_guard<ElidableShardedMutex> lockGlobal(globalMutex);
+			// the Window may have been moved or deleted meanwhile, or the destination group destroyed
+			WindowGroupMapIterator it = windowGroupMap.find(m.first);
+			if (!to || it == windowGroupMap.end() || it->second != groupID)
+				continue;
+			detachWindow(m.first);
+			to->attachWindow(m.first);
+		}
+	}
 #endif
 
 	/**
@@ -277,16 +1147,9 @@ namespace glfwm {
 	WindowGroupID WindowGroup::newGroupID() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		WindowGroupID id = windowGroups.size();
-		if (!freedWindowGroupIDs.empty()) {
-			id = freedWindowGroupIDs.front();
-			freedWindowGroupIDs.pop_front();
-		}
-		if (id >= windowGroups.size())
-			windowGroups.resize(id + 1);
-		return id;
+		return windowGroups.acquire();
 	}
 
 	/**
@@ -297,11 +1160,16 @@ namespace glfwm {
 	WindowGroupPointer WindowGroup::newGroup() {
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		WindowGroupID id = newGroupID();
-		windowGroups[id] = std::make_shared<WindowGroup>(id);
-		return windowGroups[id];
+		try {
+			*windowGroups.find(id) = std::make_shared<WindowGroup>(id);
+		} catch (...) {
+			windowGroups.release(id);
+			throw;
+		}
+		return windowGroups.get(id);
 	}
 
 	/**
@@ -310,15 +1178,37 @@ namespace glfwm {
 	 *  @return A pointer to the requested WindowGroup, if it exists, or a null pointer.
 	 */
 	WindowGroupPointer WindowGroup::getGroup(const WindowGroupID id) {
+		// ungrouped windows are routed without locking
+		if (id == NoWindowGroupID)
+			return WindowGroupPointer(nullptr);
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		return windowGroups.get(id);
+	}
+
+	/**
+	 *  @brief  The getGroupAtIndex static method returns a pointer to the WindowGroup stored in a slot.
+	 *  @param index The index of the slot, see getIndex.
+	 *  @return A pointer to the WindowGroup, if the slot is in use, or a null pointer.
+	 */
+	WindowGroupPointer WindowGroup::getGroupAtIndex(const size_t index) {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		if (id < windowGroups.size())
-			return windowGroups[id];
-		return WindowGroupPointer(nullptr);
+		return windowGroups.getAt(index);
 	}
 
+	/**
+	 *  @brief  The getIndex static method returns the index of the slot of a WindowGroup, which is small and dense
+	 * but, unlike its ID, reused as soon as the group is deleted.
+	 *  @param id The ID of the WindowGroup.
+	 *  @return The index of its slot.
+	 */
+	size_t WindowGroup::getIndex(const WindowGroupID id) { return SlotMap<WindowGroupPointer>::indexOf(id); }
+
 	/**
 	 *  @brief  The getWindowGroup static method returns the ID of the group the Window identified by id belongs to.
 	 *  @param id The ID of the Window.
@@ -326,8 +1216,8 @@ namespace glfwm {
 	 */
 	WindowGroupID WindowGroup::getWindowGroup(const WindowID id) {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		WindowGroupMapIterator it = windowGroupMap.find(id);
 		if (it != windowGroupMap.end())
@@ -335,14 +1225,27 @@ namespace glfwm {
 		return NoWindowGroupID;
 	}
 
+	/**
+	 *  @brief  The mapWindow static method records the WindowGroup a Window is attached to, both in windowGroupMap and
+	 * in the Window itself for lock-free lookups.
+	 *  @param wID The ID of the Window.
+	 *  @param gID The ID of the group, or NoWindowGroupID.
+	 */
+	void WindowGroup::mapWindow(const WindowID wID, const WindowGroupID gID) {
+		windowGroupMap[wID] = gID;
+		WindowRef w = Window::borrowWindow(wID);
+		if (w)
+			w->owningGroupID = gID;
+	}
+
 	/**
 	 *  @brief  The getAllWindowGroupsIDs static method returns the set of all the WindowGroupIDs currently in use.
 	 *  @param gIDs The set of WindowGroupIDs.
 	 */
 	void WindowGroup::getAllWindowGroupIDs(std::unordered_set<WindowGroupID>& gIDs) {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		gIDs.clear();
 		for (auto& g : windowGroups)
@@ -350,6 +1253,27 @@ namespace glfwm {
 				gIDs.insert(g->groupID);
 	}
 
+	/**
+	 *  @brief  The waitForFramesInProgress static method blocks until all the groups have ended the frame they are
+	 * drawing, if any.
+	 *  @note   It must not be called while drawing.
+	 */
+	void WindowGroup::waitForFramesInProgress() {
+#ifndef NO_MULTITHREADING
+		std::vector<WindowGroupPointer> groups;
+		{
+			// acquire shared ownership
+			SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+			for (auto& g : windowGroups)
+				if (g)
+					groups.push_back(g);
+		}
+		// each frame is drawn holding renderMutex
+		for (auto& g : groups)
+			std::lock_guard<std::mutex> renderLock(g->renderMutex);
+#endif
+	}
+
 	/**
 	 *  @brief  The getAllUngroupedWindowIDs static method returns the set of all the WindowIDs that are not attached to
 	 * any group.
@@ -357,43 +1281,148 @@ namespace glfwm {
 	 */
 	void WindowGroup::getAllUngroupedWindowIDs(std::unordered_set<WindowID>& wIDs) {
 #ifndef NO_MULTITHREADING
-		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
 #endif
 		Window::getAllWindowIDs(wIDs);
 		for (auto& wg : windowGroupMap)
 			wIDs.erase(wg.first);
 	}
 
+	/**
+	 *  @brief  The addSubtreeGroups static method adds to a set the slot indices (see getIndex) of a group and of all
+	 * the groups nested, directly or not, into it.
+	 *  @param id   The ID of the group.
+	 *  @param gIDs The set of slot indices to add to.
+	 *  @note   The set of each group is kept precomputed, so this costs a union of bitsets.
+	 */
+	void WindowGroup::addSubtreeGroups(const WindowGroupID id, DynamicBitset& gIDs) {
+#ifndef NO_MULTITHREADING
+		// acquire shared ownership
+		SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+		if (windowGroups.get(id))
+			gIDs |= windowGroups.get(id)->subtreeGroupIDs;
+	}
+
+	/**
+	 *  @brief  The updateSubtreeGroups static method recomputes the set of nested groups of each group, after a
+	 * change of the hierarchy.
+	 */
+	void WindowGroup::updateSubtreeGroups() {
+		for (auto& g : windowGroups)
+			if (g) {
+				g->subtreeGroupIDs.clear();
+				g->subtreeGroupIDs.set(getIndex(g->groupID));
+			}
+		// add each group to the sets of all its ancestors
+		for (auto& g : windowGroups)
+			if (g)
+				for (WindowGroupID p = g->parentGroupID; windowGroups.get(p); p = windowGroups.get(p)->parentGroupID)
+					windowGroups.get(p)->subtreeGroupIDs.set(getIndex(g->groupID));
+	}
+
 	/**
 	 *  @brief  The deleteWindowGroup static method destroys and removes the WindowGroup at id.
 	 *  @param id The ID of the WindowGroup to delete.
 	 */
 	void WindowGroup::deleteWindowGroup(const WindowGroupID id) {
+		// keep a reference, as destroying releases the slot
+		WindowGroupPointer g = getGroup(id);
+		if (!g)
+			return;
+		// not holding globalMutex, which the loop of the group may be waiting for
+		g->destroy();
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+		for (auto it = shareGroupLanes.begin(); it != shareGroupLanes.end(); ++it)
+			if (it->second == id) {
+				shareGroupLanes.erase(it);
+				break;
+			}
 #endif
-		if (id < windowGroups.size() && windowGroups[id]) {
-			windowGroups[id]->destroy();
-			windowGroups[id].reset();
-		}
 	}
 
 	/**
 	 *  @brief  The deleteAllWindowGroups static method destroys and removes all WindowGroup created so far.
 	 */
 	void WindowGroup::deleteAllWindowGroups() {
+		// the WindowGroups are destroyed after emptying the container, as destroying releases their slots
+		std::vector<WindowGroupPointer> deleted;
+		{
+#ifndef NO_MULTITHREADING
+			// acquire shared ownership
+			SharedLockGuard<ElidableShardedMutex> lock(globalMutex);
+#endif
+			for (auto& g : windowGroups)
+				if (g)
+					deleted.push_back(g);
+		}
+		// not holding globalMutex, which the loops of the groups may be waiting for
+		for (auto& g : deleted)
+			g->destroy();
 #ifndef NO_MULTITHREADING
 		// acquire ownership
-		std::lock_guard<std::recursive_mutex> lock(globalMutex);
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
 #endif
-		for (auto& g : windowGroups)
-			if (g)
-				g->destroy();
 		windowGroupMap.clear();
-		freedWindowGroupIDs.clear();
 		windowGroups.clear();
+#ifndef NO_MULTITHREADING
+		shareGroupLanes.clear();
+#endif
 	}
 
+#ifndef NO_MULTITHREADING
+	/**
+	 *  @brief  The setShareGroupLanes static method enables or disables the automatic attachment of each new Window
+	 * created by the WindowManager to a lane: a group running concurrently which holds all and only the Windows
+	 * sharing their contexts. This way, Windows sharing their contexts are never drawn by concurrent threads, which
+	 * would serialize on their shared mutex.
+	 *  @param lanes true for attaching new Windows to lanes, false otherwise.
+	 */
+	void WindowGroup::setShareGroupLanes(const bool lanes) { useShareGroupLanes = lanes; }
+
+	/**
+	 *  @brief  The isUsingShareGroupLanes static method says if new Windows are attached to lanes.
+	 *  @return true if attaching new Windows to lanes, false otherwise.
+	 */
+	bool WindowGroup::isUsingShareGroupLanes() { return useShareGroupLanes; }
+
+	/**
+	 *  @brief  The getShareGroupLane static method returns the lane of a share group, creating and starting it if it
+	 * does not exist yet.
+	 *  @param contextShareID The share group of the contexts, see Window::getContextShareID.
+	 *  @return A pointer to the lane.
+	 */
+	WindowGroupPointer WindowGroup::getShareGroupLane(const size_t contextShareID) {
+		// acquire ownership
+		std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+		std::unordered_map<size_t, WindowGroupID>::iterator it = shareGroupLanes.find(contextShareID);
+		if (it != shareGroupLanes.end() && getGroup(it->second))
+			return getGroup(it->second);
+		WindowGroupPointer lane = newGroup();
+		lane->runLoopConcurrently();
+		shareGroupLanes[contextShareID] = lane->getID();
+		return lane;
+	}
+
+	/**
+	 *  @brief  The deleteEmptyShareGroupLanes static method destroys and removes the lanes without Windows.
+	 */
+	void WindowGroup::deleteEmptyShareGroupLanes() {
+		std::vector<WindowGroupID> emptyLanes;
+		{
+			// acquire ownership
+			std::lock_guard<ElidableShardedMutex> lock(globalMutex);
+			for (auto& l : shareGroupLanes)
+				if (windowGroups.get(l.second) && windowGroups.get(l.second)->empty())
+					emptyLanes.push_back(l.second);
+		}
+		// not holding globalMutex, which the loops of the lanes may be waiting for
+		for (auto id : emptyLanes)
+			deleteWindowGroup(id);
+	}
+#endif
+
 }
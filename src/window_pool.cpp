@@ -0,0 +1,147 @@
+// Copyright (c) 2015-2024 Giorgio Marcias
+//
+// This file is part of GLFWM, a C++11 wrapper of GLFW with
+// multi-threading management (GLFW Manager).
+//
+// This source code is subject to zlib/libpng License.
+// This software is provided 'as-is', without any express
+// or implied warranty. In no event will the authors be held
+// liable for any damages arising from the use of this software.
+//
+// Author: Giorgio Marcias
+// email: marcias.giorgio@gmail.com
+
+#include <GLFWM/window_pool.hpp>
+
+namespace glfwm {
+
+	/**
+	 *  @brief  The GLFW windows kept, oldest first.
+	 */
+	std::deque<WindowPool::Entry> WindowPool::entries;
+
+	/**
+	 *  @brief  The maximum number of GLFW windows kept.
+	 */
+	size_t WindowPool::capacity = 0;
+
+	/**
+	 *  @brief  The setCapacity static method sets the maximum number of GLFW windows kept, destroying the oldest ones
+	 * in excess.
+	 *  @param capacity The maximum number of windows. 0, the default, disables the pool.
+	 */
+	void WindowPool::setCapacity(const size_t capacity) {
+		WindowPool::capacity = capacity;
+		while (entries.size() > capacity) {
+			glfwDestroyWindow(entries.front().glfwWindow);
+			entries.pop_front();
+		}
+	}
+
+	/**
+	 *  @brief  The getCapacity static method returns the maximum number of GLFW windows kept.
+	 *  @return The maximum number of windows.
+	 */
+	size_t WindowPool::getCapacity() { return capacity; }
+
+	/**
+	 *  @brief  The getSize static method returns the number of GLFW windows kept.
+	 *  @return The number of windows.
+	 */
+	size_t WindowPool::getSize() { return entries.size(); }
+
+	/**
+	 *  @brief  The clear static method destroys all the GLFW windows kept.
+	 */
+	void WindowPool::clear() {
+		for (auto& e : entries)
+			glfwDestroyWindow(e.glfwWindow);
+		entries.clear();
+	}
+
+	/**
+	 *  @brief  The makeKey static method returns the hints determining whether a GLFW window can be recycled.
+	 *  @param hints The hints the window is created with, on top of the default ones.
+	 *  @return The hints sorted by target, the last value for each target, without the visibility.
+	 */
+	WindowPool::Hints WindowPool::makeKey(const Hints& hints) {
+		Hints key;
+		for (auto& h : hints) {
+			// recycled windows are shown when handed out, if visible
+			if (h.first == GLFW_VISIBLE)
+				continue;
+			Hints::iterator it = std::lower_bound(
+			    key.begin(), key.end(), h, [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+				    return a.first < b.first;
+			    });
+			if (it != key.end() && it->first == h.first)
+				it->second = h.second;
+			else
+				key.insert(it, h);
+		}
+		return key;
+	}
+
+	/**
+	 *  @brief  The acquire static method takes a GLFW window out of the pool.
+	 *  @param key The hints of the window, see makeKey.
+	 *  @return The GLFW window, hidden, or null if none has been created with the same hints.
+	 */
+	GLFWwindow* WindowPool::acquire(const Hints& key) {
+		// the most recent first, as the least likely to be swapped out
+		for (std::deque<Entry>::reverse_iterator it = entries.rbegin(); it != entries.rend(); ++it)
+			if (it->hints == key) {
+				GLFWwindow* w = it->glfwWindow;
+				entries.erase(std::next(it).base());
+				return w;
+			}
+		return nullptr;
+	}
+
+	/**
+	 *  @brief  The release static method puts a GLFW window into the pool, hiding it and resetting its callbacks and
+	 * properties.
+	 *  @param glfwWindow The GLFW window, whose user pointer must be null.
+	 *  @param key        The hints of the window, see makeKey.
+	 *  @return true if kept, false if the pool is full, in which case the window must be destroyed by the caller.
+	 */
+	bool WindowPool::release(GLFWwindow* glfwWindow, const Hints& key) {
+		if (entries.size() >= capacity)
+			return false;
+		glfwHideWindow(glfwWindow);
+		if (glfwGetCurrentContext() == glfwWindow)
+			glfwMakeContextCurrent(nullptr);
+		// the next Window registers its own callbacks
+		glfwSetWindowPosCallback(glfwWindow, nullptr);
+		glfwSetWindowSizeCallback(glfwWindow, nullptr);
+		glfwSetWindowCloseCallback(glfwWindow, nullptr);
+		glfwSetWindowRefreshCallback(glfwWindow, nullptr);
+		glfwSetWindowFocusCallback(glfwWindow, nullptr);
+		glfwSetWindowIconifyCallback(glfwWindow, nullptr);
+		glfwSetWindowMaximizeCallback(glfwWindow, nullptr);
+		glfwSetFramebufferSizeCallback(glfwWindow, nullptr);
+		glfwSetWindowContentScaleCallback(glfwWindow, nullptr);
+		glfwSetMouseButtonCallback(glfwWindow, nullptr);
+		glfwSetCursorPosCallback(glfwWindow, nullptr);
+		glfwSetCursorEnterCallback(glfwWindow, nullptr);
+		glfwSetScrollCallback(glfwWindow, nullptr);
+		glfwSetKeyCallback(glfwWindow, nullptr);
+		glfwSetCharCallback(glfwWindow, nullptr);
+		glfwSetCharModsCallback(glfwWindow, nullptr);
+		glfwSetDropCallback(glfwWindow, nullptr);
+		// the properties a new window would not have
+		glfwRestoreWindow(glfwWindow);
+		glfwSetWindowShouldClose(glfwWindow, GL_FALSE);
+		glfwSetWindowOpacity(glfwWindow, 1.0f);
+		glfwSetWindowSizeLimits(glfwWindow, GLFW_DONT_CARE, GLFW_DONT_CARE, GLFW_DONT_CARE, GLFW_DONT_CARE);
+		glfwSetWindowAspectRatio(glfwWindow, GLFW_DONT_CARE, GLFW_DONT_CARE);
+		glfwSetCursor(glfwWindow, nullptr);
+		glfwSetInputMode(glfwWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+		Entry e;
+		e.hints = key;
+		e.glfwWindow = glfwWindow;
+		entries.push_back(e);
+		return true;
+	}
+
+}